@@ -352,28 +352,17 @@ void showRDSStation() {
 }
 
 void showRDSTime() {
-  char *p;
+  char pty[SI470X_RDS_PTY_NAME_SIZE];
   if (rdsTime == NULL || (millis() - delayTime) < 60000) return;
 
-  // Shows also the current program type.
+  // Shows also the current program type. The names are stored in the flash memory by the library.
   display.fillRect(0, 32, 84, 8, WHITE);
   display.setCursor(0, 32);
   display.print(rx.getRdsProgramType());
-  switch (rx.getRdsProgramType()) {
-    case 1: p = (char *) "News"; break;
-    case 3:
-    case 4: p = (char *) "Info/Sport"; break;
-    case 7: p = (char *) "Culture"; break;
-    case 10:
-    case 11:
-    case 12:
-    case 13:
-    case 14:
-    case 15: p = (char *) "Music"; break;
-    default: p = (char *) "Other";
-  }
+  rx.getRdsProgramTypeName(rx.getRdsProgramType(), pty);
+  pty[11] = 0; // Fits the display
   display.setCursor(15, 32);
-  display.print(p);
+  display.print(pty);
 
   display.fillRect(42, 40, 42, 8, WHITE);
   display.setCursor(50, 40);
@@ -17,6 +17,9 @@ echo "Arduino ATmega328 based board"
 echo "********************"
 arduino-cli compile -b arduino:avr:nano ./si470x_01_serial_monitor/si470x_00_CIRCUIT_TEST --output-dir ~/Downloads/hex/atmega/si470x_00_CIRCUIT_TEST  --warnings all
 arduino-cli compile -b arduino:avr:nano ./si470x_01_serial_monitor/si470x_01_RDS --output-dir ~/Downloads/hex/atmega/si470x_01_RDS  --warnings all
+arduino-cli compile -b arduino:avr:nano ./si470x_01_serial_monitor/si470x_04_BUS_TRAFFIC --output-dir ~/Downloads/hex/atmega/si470x_04_BUS_TRAFFIC  --warnings all
+arduino-cli compile -b arduino:avr:nano ./si470x_01_serial_monitor/si470x_05_RDS_CALLBACKS --output-dir ~/Downloads/hex/atmega/si470x_05_RDS_CALLBACKS  --warnings all
+arduino-cli compile -b arduino:avr:nano ./si470x_01_serial_monitor/si470x_06_RDS_RECORDER --output-dir ~/Downloads/hex/atmega/si470x_06_RDS_RECORDER  --warnings all
 arduino-cli compile -b arduino:avr:nano ./si470x_02_TFT_display --output-dir ~/Downloads/hex/atmega/si470x_02_TFT_display  --warnings all
 arduino-cli compile -b arduino:avr:nano ./SI470X_06_NOKIA5110_RDS --output-dir ~/Downloads/hex/atmega/SI470X_06_NOKIA5110_RDS  --warnings all
 
@@ -0,0 +1,95 @@
+/*
+   Shows the I2C bus traffic and the time spent by the library on the bus.
+   It is useful to check the read wait strategy (SI470X_READ_WAIT) selected for your board and
+   the number of bytes saved by the register cache.
+   The bus counters are off by default on AVR boards (SI470X_BUS_STATS, see SI470X.h). Build the sketch with them, for example:
+   arduino-cli compile --fqbn arduino:avr:pro --build-property "compiler.cpp.extra_flags=-DSI470X_BUS_STATS=1"
+
+    Arduino Pro Mini and SI4703 wire up
+
+    | Device  Si470X |  Arduino Pin  |
+    | ---------------| ------------  |
+    | RESET          |     14/A0     |
+    | SDIO           |     A4        |
+    | SCLK           |     A5        |
+
+
+   ATTENTION:
+   Please, avoid using the computer connected to the mains during testing. Used just the battery of your computer.
+   This sketch was tested on ATmega328 based board. If you are not using a ATmega328, please check the pins of your board.
+
+   By Ricardo Lima Caratti, 2020.
+*/
+
+#include <SI470X.h>
+
+#define RESET_PIN 14 // On Arduino Atmega328 based board, this pin is labeled as A0 (14 means digital pin instead analog)
+#define STATUS_POLLS 100
+
+SI470X rx;
+
+void showStats(const char *name, si470x_bus_stats before)
+{
+  si470x_bus_stats after = rx.getBusStats();
+
+  Serial.print(name);
+  Serial.print(": written ");
+  Serial.print(after.bytesWritten - before.bytesWritten);
+  Serial.print(" bytes (saved ");
+  Serial.print(after.bytesSaved - before.bytesSaved);
+  Serial.print("); read ");
+  Serial.print(after.bytesRead - before.bytesRead);
+  Serial.print(" bytes in ");
+  Serial.print(after.readTransactions - before.readTransactions);
+  Serial.print(" transactions / ");
+  Serial.print(after.readMicros - before.readMicros);
+  Serial.println(" us");
+}
+
+void setup()
+{
+  si470x_bus_stats before;
+
+  Serial.begin(9600);
+  while (!Serial)
+    ;
+
+  Serial.print("\nRead wait strategy: ");
+  Serial.println((SI470X_READ_WAIT == SI470X_READ_WAIT_FIXED) ? "fixed delay" : (SI470X_READ_WAIT == SI470X_READ_WAIT_NONE) ? "none (blocking requestFrom)" : "available() polling");
+#if !SI470X_BUS_STATS
+  Serial.println("The bus counters are off: build with -DSI470X_BUS_STATS=1");
+#endif
+
+  before = rx.getBusStats();
+  rx.setup(RESET_PIN, A4);
+  showStats("setup", before);
+
+  before = rx.getBusStats();
+  rx.setVolume(6);
+  showStats("setVolume(6)", before);
+
+  before = rx.getBusStats();
+  rx.setVolume(6);
+  showStats("setVolume(6) again", before);
+
+  before = rx.getBusStats();
+  rx.setFrequency(10650); // The frequency you want to select in MHz multiplied by 100.
+  showStats("setFrequency(10650)", before);
+
+  before = rx.getBusStats();
+  rx.getRealFrequency();
+  showStats("getRealFrequency", before);
+
+  before = rx.getBusStats();
+  for (int i = 0; i < STATUS_POLLS; i++)
+    rx.getRssi();
+  showStats("100 x getRssi", before);
+
+  Serial.print("Average status poll: ");
+  Serial.print((rx.getBusStats().readMicros - before.readMicros) / STATUS_POLLS);
+  Serial.println(" us");
+}
+
+void loop()
+{
+}
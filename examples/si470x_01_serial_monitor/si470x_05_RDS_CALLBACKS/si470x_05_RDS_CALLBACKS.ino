@@ -0,0 +1,84 @@
+/*
+   Shows the RDS information by using callbacks.
+   The sketch does not compare strings or refresh the display in the loop: the functions below are
+   called only when the station name, the radio text, the time, the program type or the traffic
+   announcement state change.
+
+    Arduino Pro Mini and SI4703 wire up
+
+    | Device  Si470X |  Arduino Pin  |
+    | ---------------| ------------  |
+    | RESET          |     14/A0     |
+    | SDIO           |     A4        |
+    | SCLK           |     A5        |
+
+
+   ATTENTION:
+   Please, avoid using the computer connected to the mains during testing. Used just the battery of your computer.
+   This sketch was tested on ATmega328 based board. If you are not using a ATmega328, please check the pins of your board.
+
+   By Ricardo Lima Caratti, 2020.
+*/
+
+#include <SI470X.h>
+
+#define RESET_PIN 14 // On Arduino Atmega328 based board, this pin is labeled as A0 (14 means digital pin instead analog)
+
+SI470X rx;
+
+void showStationName(const char *ps)
+{
+  Serial.print("\nStation: ");
+  Serial.print(ps);
+}
+
+void showRadioText(const char *text)
+{
+  Serial.print("\nText: ");
+  Serial.print(text);
+}
+
+void showTime(const si470x_rds_clock_time *ct)
+{
+  char buffer[20];
+  sprintf(buffer, "%04u-%02u-%02u %02u:%02u", ct->year, ct->month, ct->day, ct->hour, ct->minute);
+  Serial.print("\nTime: ");
+  Serial.print(buffer);
+}
+
+void showPty(uint8_t pty)
+{
+  Serial.print("\nProgram type: ");
+  Serial.print(pty);
+}
+
+void showTrafficAnnouncement(bool active)
+{
+  Serial.print((active) ? "\nTraffic announcement started" : "\nTraffic announcement finished");
+}
+
+void setup()
+{
+  Serial.begin(9600);
+  while (!Serial)
+    ;
+
+  rx.setup(RESET_PIN, A4);
+  rx.setVolume(6);
+
+  rx.onProgramServiceChanged(showStationName);
+  rx.onRadioTextChanged(showRadioText);
+  rx.onClockTime(showTime);
+  rx.onPtyChanged(showPty);
+  rx.onTrafficAnnouncement(showTrafficAnnouncement);
+
+  rx.setFrequency(10650); // The frequency you want to select in MHz multiplied by 100.
+  rx.setRds(true);
+  rx.setSeekThreshold(30); // Sets RSSI Seek Threshold (0 to 127)
+}
+
+void loop()
+{
+  rx.getRdsReady(); // Decodes the new RDS group (if any) and calls the functions above when something changes
+  delay(20);
+}
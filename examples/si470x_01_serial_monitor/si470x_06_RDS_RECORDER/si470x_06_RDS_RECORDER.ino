@@ -0,0 +1,55 @@
+/*
+   Records the raw RDS groups (binary, 11 bytes per group) to the serial port.
+   Use it to reproduce RDS problems of a station on a computer without the radio:
+   save the serial output to a file (for example, "cat /dev/ttyUSB0 > field.rds" after setting the port to 115200 bauds)
+   and run "si470x_host_benchmark replay field.rds" (see extras/host). The groups go to the same decoder used here.
+
+   The serial output is binary. Do not open the Serial Monitor while recording.
+
+    Arduino Pro Mini and SI4703 wire up
+
+    | Device  Si470X |  Arduino Pin  |
+    | ---------------| ------------  |
+    | RESET          |     14/A0     |
+    | SDIO           |     A4        |
+    | SCLK           |     A5        |
+
+
+   ATTENTION:
+   Please, avoid using the computer connected to the mains during testing. Used just the battery of your computer.
+   This sketch was tested on ATmega328 based board. If you are not using a ATmega328, please check the pins of your board.
+
+   By Ricardo Lima Caratti, 2020.
+*/
+
+#include <SI470X.h>
+
+#define RESET_PIN 14 // On Arduino Atmega328 based board, this pin is labeled as A0 (14 means digital pin instead analog)
+
+SI470X rx;
+
+void recordGroup(const uint8_t *record, uint8_t size)
+{
+  Serial.write(record, size);
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+
+  rx.setup(RESET_PIN, A4);
+  rx.setVolume(6);
+
+  rx.setFrequency(10650); // The frequency you want to select in MHz multiplied by 100.
+  rx.setRds(true);
+  rx.setRdsMode(1);       // Verbose: the block errors (BLERA to BLERD) are recorded too
+  rx.setRdsRecorder(recordGroup);
+}
+
+void loop()
+{
+  rx.processRdsGroup(); // Each new group is sent to recordGroup (and decoded as usual)
+  delay(20);
+}
@@ -0,0 +1,25 @@
+# This script uses the arduino-cli to show the flash and RAM used by a sketch with each RDS decoder configuration (SI470X_RDS_DECODERS).
+# The decoders left out of SI470X_RDS_DECODERS are removed from the library (code and buffers). See SI470X.h.
+# The ATtiny default is SI470X_RDS_DECODE_PS | SI470X_RDS_DECODE_RT | SI470X_RDS_DECODE_CT (0x15).
+# The other AVR boards leave out AF and EON (0x3F). On both, the RDS cache and the radio text work buffer (SI470X_RDS_RT_WORK) are off
+# and the RDS FIFO keeps one group. Add -DSI470X_RDS_CACHE_SIZE=2 -DSI470X_RDS_FIFO_SIZE=8 -DSI470X_RDS_RT_WORK=1 to the flags to compare.
+# The counters (SI470X_RDS_STATS, SI470X_BUS_STATS, SI470X_RDS_BLOCK_STATS, SI470X_RDS_FIFO_STATS and SI470X_SEEK_STATS) are off on AVR; the RDS callbacks and the traffic mode are off on ATtiny.
+# Usage: ./size_report.sh [fqbn] [sketch]
+# Please, see the file config_libraries_and_boards.sh
+
+FQBN=${1:-ATTinyCore:avr:attinyx5:millis=enabled}
+SKETCH=${2:-./SI470X_04_ATTINY_84_85/SI470X_04_ATTINY85_RDS_OLED96_EEPROM}
+
+# name:SI470X_RDS_DECODERS
+CONFIGS="all:0xFF ps+rt+ct:0x15 ps+rt:0x05 ps+ct:0x11 ps:0x01 none:0x00"
+
+echo "********************"
+echo "$SKETCH ($FQBN)"
+echo "********************"
+for config in $CONFIGS
+do
+  name=${config%%:*}
+  decoders=${config##*:}
+  echo "--- $name (SI470X_RDS_DECODERS=$decoders)"
+  arduino-cli compile --fqbn $FQBN $SKETCH --build-property "compiler.cpp.extra_flags=-DSI470X_RDS_DECODERS=$decoders" 2>&1 | grep -E "Sketch uses|Global variables|error"
+done
@@ -0,0 +1,584 @@
+/*
+   Runs the SI470X library on a host computer (Linux or macOS) against a simulated device and
+   shows the I2C traffic (transactions and bytes) of each public function.
+
+   It is not an Arduino sketch. Build it with "make" (see the Makefile in this folder) or:
+
+   g++ -O2 -I ../../src si470x_host_benchmark.cpp ../../src/SI470X.cpp ../../src/SI470XHost.cpp ../../src/SI470XSim.cpp ../../src/SI470XLinuxBus.cpp -o si470x_host_benchmark
+
+   Run "./si470x_host_benchmark" to talk to the simulated device directly or
+   "./si470x_host_benchmark linux" to go through the Linux i2c-dev transport (I2C_RDWR) with a
+   stand-in file descriptor. In this case, the last column shows the number of kernel calls.
+   "./si470x_host_benchmark replay file.rds" decodes an RDS recording (see SI470X::setRdsRecorder) and
+   shows the result and the decoder throughput.
+
+   By Ricardo Lima Caratti, 2020.
+*/
+
+#include <stdio.h>
+#include <time.h>
+#include <SI470X.h>
+#include <SI470XSim.h>
+
+#define SIM_GPIO2_PIN 2 // Host "pin" connected to the simulated GPIO2
+#define EON_TA_GROUP 10 // Index of the group 14B in rdsGroups
+
+// Traffic station (EON linked to PU2CLR). PS "TRAFFIC ", TP = 1 and TA = 1. PI = 0xE0F2
+si470x_rds_group trafficGroups[] = {
+    {0xE0F2, 0x0410, 0xE0CD, 0x5452, 0}, // 0A, segment 0: "TR"
+    {0xE0F2, 0x0411, 0xE0CD, 0x4146, 0}, // 0A, segment 1: "AF"
+    {0xE0F2, 0x0412, 0xE0CD, 0x4649, 0}, // 0A, segment 2: "FI"
+    {0xE0F2, 0x0413, 0xE0CD, 0x4320, 0}  // 0A, segment 3: "C "
+};
+
+si470x_sim_station stations[] = {
+    {100, 45, NULL, 0}, // 97.5 MHz  (Band 0, Space 1 = 100 kHz)
+    {150, 30, NULL, 0}, // 102.5 MHz
+    {164, 40, trafficGroups, sizeof(trafficGroups) / sizeof(si470x_rds_group)}, // 103.9 MHz
+    {190, 52, NULL, 0}  // 106.5 MHz
+};
+
+// PS "PU2CLR  " (group 0A), AF list (method A) with the 3 stations and RT "Hi PU2CLR" (group 2A, ends with 0x0D). PI = 0xE0F1
+si470x_rds_group rdsGroups[] = {
+    {0xE0F1, 0x0400, 0xE364, 0x5055, 0}, // 0A, segment 0: "PU", AF: 3 frequencies follow, 97.5 MHz
+    {0xE0F1, 0x2400, 0x4869, 0x2050, 0}, // 2A, segment 0: "Hi P"
+    {0xE0F1, 0x0401, 0x96BE, 0x3243, 0}, // 0A, segment 1: "2C", AF: 102.5 MHz, 106.5 MHz
+    {0xE0F1, 0x2401, 0x5532, 0x434C, 0}, // 2A, segment 1: "U2CL"
+    {0xE0F1, 0x0402, 0xE364, 0x4C52, 0}, // 0A, segment 2: "LR"
+    {0xE0F1, 0x2402, 0x520D, 0x2020, 0}, // 2A, segment 2: "R\r  "
+    {0xE0F1, 0x0403, 0x96BE, 0x2020, 0}, // 0A, segment 3: "  "
+    {0xE0F1, 0x4001, 0xCE07, 0x7B42, 0}, // 4A: MJD 59139 (2020-10-17), 23:45 UTC, +01:00
+    {0xE0F1, 0x1000, 0x00E0, 0x8D00, 0}, // 1A, variant 0: ECC 0xE0, PIN day 17 20:00
+    {0xE0F1, 0xE015, 0xBEA4, 0xE0F2, 0}, // 14A, variant 5: 106.5 MHz is mapped to 103.9 MHz on the other network 0xE0F2 (TP = 1)
+    {0xE0F1, 0xE818, 0xE0F1, 0xE0F2, 0}, // 14B: traffic announcement on the other network 0xE0F2 (see EON_TA_GROUP)
+    {0xE0F1, 0x0401, 0xE0CD, 0x2323, 3}, // 0A, segment 1: "##" - block D uncorrectable (verbose mode only)
+    {0xE0F1, 0x2400, 0x5858, 0x2050, 8}, // 2A, segment 0: "XX P" - 3-5 errors corrected in block C (verbose mode only)
+    {0xE0F1, 0xA000, 0x466F, 0x6F74, 0}, // 10A, segment 0: PTYN "Foot"
+    {0xE0F1, 0xA001, 0x6261, 0x6C6C, 0}, // 10A, segment 1: PTYN "ball"
+    {0xE0F1, 0x3016, 0x0000, 0x4BD7, 0}, // 3A: RadioText Plus (AID 0x4BD7) in the group 11A
+    {0xE0F1, 0xB008, 0x818A, 0x0801, 0}  // 11A: RT+ item running, ARTIST = RT[3..8] ("PU2CLR"), TITLE = RT[0..1] ("Hi")
+};
+
+SI470XSim sim;
+SI470X rx;
+
+#if defined(__linux__)
+SI470XSimLinuxBus linuxBus(&sim);
+#endif
+uint32_t kernelCalls()
+{
+#if defined(__linux__)
+    return linuxBus.kernelCalls;
+#else
+    return 0;
+#endif
+}
+
+void showTraffic(const char *name, si470x_bus_stats before, unsigned long elapsed, uint32_t calls)
+{
+    si470x_bus_stats after = rx.getBusStats();
+
+    printf("%-28s | %5u wr | %5u bytes wr | %5u saved | %5u rd | %6u bytes rd | %8lu us | %5u\n",
+           name,
+           after.writeTransactions - before.writeTransactions,
+           after.bytesWritten - before.bytesWritten,
+           after.bytesSaved - before.bytesSaved,
+           after.readTransactions - before.readTransactions,
+           after.bytesRead - before.bytesRead,
+           elapsed,
+           kernelCalls() - calls);
+}
+
+/**
+ * Tunes a frequency with setFrequencyAsync and polls it like a busy sketch loop would.
+ * The latency is the time from STC = 1 (simulated device) to poll() returning true.
+ */
+void asyncTune(SI470X &radio, const char *name, uint16_t frequency)
+{
+    si470x_bus_stats before = radio.getBusStats(), after;
+    unsigned long start = micros();
+    uint32_t iterations = 0;
+
+    radio.setFrequencyAsync(frequency);
+    while (!radio.poll())
+    {
+        delayMicroseconds(100); // Simulates other work done by the loop
+        iterations++;
+    }
+    after = radio.getBusStats();
+    printf("%-28s | %5u wr | %5u rd | %6u bytes rd | %8lu us | STC latency %lu us | %u loop iterations\n",
+           name,
+           after.writeTransactions - before.writeTransactions,
+           after.readTransactions - before.readTransactions,
+           after.bytesRead - before.bytesRead,
+           micros() - start,
+           micros() - sim.stcTime,
+           iterations);
+}
+
+/**
+ * Runs a loop that captures RDS groups every "busy" ms (time spent on other tasks)
+ * and processes them only every 500 ms (slow display update).
+ */
+void rdsRun(SI470X &radio, const char *name, unsigned long busy)
+{
+    si470x_bus_stats before = radio.getBusStats(), after;
+    si470x_rds_group group;
+    si470x_rds_fifo_stats fifo;
+    uint32_t sent = sim.rdsGroupsSent, processed = 0;
+    unsigned long start = millis(), display = millis();
+
+    radio.resetRdsFifoStats();
+    radio.clearRdsFifo();
+    while ((millis() - start) < 5000)
+    {
+        delay(busy);
+        radio.rdsCapture();
+        if ((millis() - display) >= 500)
+        {
+            while (radio.getRdsGroup(&group))
+            {
+                radio.processRdsGroup(&group);
+                processed++;
+            }
+            display = millis();
+        }
+    }
+    after = radio.getBusStats();
+    fifo = radio.getRdsFifoStats();
+    printf("%-28s | %5u rd | %6u bytes rd | sent %3u | received %3u | processed %3u | dropped %3u | missed %3u | max used %2u\n",
+           name,
+           after.readTransactions - before.readTransactions,
+           after.bytesRead - before.bytesRead,
+           sim.rdsGroupsSent - sent,
+           fifo.received, processed, fifo.dropped, fifo.missed, fifo.maxUsed);
+}
+
+void showRds(SI470X &radio)
+{
+    si470x_rds_block_stats blocks = radio.getRdsBlockStats();
+
+    printf("%-28s | PS \"%s\" (version %u) | RT \"%s\" (version %u) | accepted A %u B %u C %u D %u | rejected A %u B %u C %u D %u\n", "",
+           radio.getRdsStationName() ? radio.getRdsStationName() : "", radio.getRdsStationNameVersion(),
+           radio.getRdsProgramInformation() ? radio.getRdsProgramInformation() : "", radio.getRdsTextVersion(),
+           blocks.accepted[0], blocks.accepted[1], blocks.accepted[2], blocks.accepted[3],
+           blocks.rejected[0], blocks.rejected[1], blocks.rejected[2], blocks.rejected[3]);
+}
+
+/**
+ * Tunes a station (as a sketch does: setFrequency + clearRdsBuffer) and shows the time until the station name is shown.
+ */
+void timeToName(SI470X &radio, const char *name, uint16_t frequency)
+{
+    si470x_rds_group group;
+    unsigned long start;
+
+    radio.setFrequency(frequency);
+    radio.clearRdsBuffer();
+    start = millis();
+    while (radio.getRdsStationName() == NULL && (millis() - start) < 5000)
+    {
+        delay(20);
+        radio.rdsCapture();
+        while (radio.getRdsGroup(&group))
+            radio.processRdsGroup(&group);
+    }
+    printf("%-28s | %5lu ms | PS \"%s\"\n", name, millis() - start, radio.getRdsStationName() ? radio.getRdsStationName() : "");
+}
+
+void showTrafficAnnouncement(bool active)
+{
+    printf("%-28s | %s | %u | PS \"%s\"\n", "onTrafficAnnouncement", active ? "started " : "finished", rx.getFrequency(),
+           rx.getRdsStationName() ? rx.getRdsStationName() : "");
+}
+
+int rdsCallbacks = 0;
+
+void showPs(const char *ps)
+{
+    rdsCallbacks++;
+    printf("%-28s | PS \"%s\"\n", "onProgramServiceChanged", ps);
+}
+
+void showRt(const char *text)
+{
+    rdsCallbacks++;
+    printf("%-28s | RT \"%s\"\n", "onRadioTextChanged", text);
+}
+
+void showCt(const si470x_rds_clock_time *ct)
+{
+    rdsCallbacks++;
+    printf("%-28s | %04u-%02u-%02u %02u:%02u (local)\n", "onClockTime", ct->year, ct->month, ct->day, ct->hour, ct->minute);
+}
+
+void showPty(uint8_t pty)
+{
+    rdsCallbacks++;
+    printf("%-28s | PTY %u\n", "onPtyChanged", pty);
+}
+
+int seekProgressEvents = 0;
+
+void showSeekEvent(uint8_t event, uint16_t frequency)
+{
+    const char *name[] = {"progress", "found", "failed", "cancelled"};
+    if (event == SI470X_SEEK_EVENT_PROGRESS)
+        seekProgressEvents++;
+    printf("%-28s | %s %u\n", "seek event", name[event], frequency);
+}
+
+// RDS recorder sink: the records are kept in memory (a sketch would write them to Serial or to an SD card)
+uint8_t recording[4096];
+size_t recordingSize = 0;
+
+void recordGroup(const uint8_t *record, uint8_t size)
+{
+    if (recordingSize + size <= sizeof(recording))
+    {
+        memcpy(recording + recordingSize, record, size);
+        recordingSize += size;
+    }
+}
+
+/**
+ * Decodes a recording (timed, as received) and then measures the decoder throughput (CPU time, untimed).
+ */
+void replayRds(SI470XRdsReplay &replay, const char *name)
+{
+    SI470X radio;
+    si470x_rds_stats stats;
+    uint32_t groups = 0;
+    clock_t start;
+
+    radio.clearRdsBuffer();
+    radio.resetRdsStats();
+    replay.rewind();
+    printf("%-28s | %u groups decoded", name, (unsigned)replay.decode(radio, true));
+    stats = radio.getRdsStats();
+    printf(" (%u valid) | %u.%u groups/s\n", (unsigned)stats.validGroups, stats.groupRate / 10, stats.groupRate % 10);
+    showRds(radio);
+
+    start = clock();
+    while (groups < 1000000 && replay.getGroupCount() != 0)
+    {
+        replay.rewind();
+        groups += replay.decode(radio);
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("%-28s | %u groups in %.3f s | %.0f groups/s\n", "decoder throughput", (unsigned)groups, seconds,
+           seconds > 0 ? groups / seconds : 0);
+}
+
+// Application RDS handlers (see addRdsOdaHandler and addRdsGroupHandler)
+unsigned odaGroups = 0, group1Groups = 0;
+
+void countOda(const si470x_rds_group *group, uint8_t valid)
+{
+    (void)group;
+    (void)valid;
+    odaGroups++;
+}
+
+void countGroup1A(const si470x_rds_group *group, uint8_t valid)
+{
+    (void)group;
+    (void)valid;
+    group1Groups++;
+}
+
+#define MEASURE(name, call)                              \
+    {                                                    \
+        si470x_bus_stats before = rx.getBusStats();      \
+        uint32_t calls = kernelCalls();                  \
+        unsigned long start = micros();                  \
+        call;                                            \
+        showTraffic(name, before, micros() - start, calls); \
+    }
+
+int main(int argc, char *argv[])
+{
+    si470xHostUseVirtualClock(true); // delay() does not sleep. The simulated bus advances the clock.
+
+    if (argc > 2 && strcmp(argv[1], "replay") == 0)
+    {
+        SI470XRdsReplay replay;
+        if (!replay.load(argv[2]))
+        {
+            printf("Cannot read %s\n", argv[2]);
+            return 1;
+        }
+        printf("\nRDS replay (%s)\n\n", argv[2]);
+        replayRds(replay, "replay");
+        return 0;
+    }
+
+    sim.setStations(stations, sizeof(stations) / sizeof(si470x_sim_station));
+    SI470XBus *bus = &sim;
+#if defined(__linux__)
+    if (argc > 1 && strcmp(argv[1], "linux") == 0)
+        bus = &linuxBus;
+#else
+    (void)argc;
+    (void)argv;
+#endif
+    rx.setBus(bus);
+
+    printf("\nSI470X I2C traffic per function (simulated device, 100 kHz)\n\n");
+
+    MEASURE("setup", rx.setup(0, -1));
+    MEASURE("setVolume(8)", rx.setVolume(8));
+    MEASURE("setVolume(8) again", rx.setVolume(8));
+    MEASURE("setMono(true)", rx.setMono(true));
+    MEASURE("setRds(true)", rx.setRds(true));
+    MEASURE("setFrequency(9750)", rx.setFrequency(9750));
+    MEASURE("getRealFrequency", rx.getRealFrequency());
+    MEASURE("getRssi", rx.getRssi());
+    MEASURE("isStereo", rx.isStereo());
+    MEASURE("getRdsReady", rx.getRdsReady());
+    MEASURE("getRdsStationName", rx.getRdsStationName());
+    MEASURE("getRdsProgramInformation", rx.getRdsProgramInformation());
+    MEASURE("getRdsTime", rx.getRdsTime());
+    MEASURE("seek up", rx.seek(SI470X_SEEK_WRAP, SI470X_SEEK_UP));
+    MEASURE("seek down (showFunc)", rx.seek(SI470X_SEEK_WRAP, SI470X_SEEK_DOWN, NULL));
+    MEASURE("setFrequencyUp", rx.setFrequencyUp());
+
+    // Non-blocking tune: the loop is free while the device tunes
+    asyncTune(rx, "setFrequencyAsync + poll", 10650);
+
+    // Non-blocking seek cancelled after a few channels (for example, the user turned the encoder)
+    {
+        rx.setSeekEventHandler(showSeekEvent);
+        rx.seekAsync(SI470X_SEEK_WRAP, SI470X_SEEK_UP);
+        while (!rx.poll())
+        {
+            delay(1);
+            if (seekProgressEvents == 5)
+                rx.cancelSeek();
+        }
+        rx.setSeekEventHandler(NULL);
+    }
+
+    si470x_seek_stats seek = rx.getSeekStats();
+    printf("\nSeeks: %u (found %u, failed %u, cancelled %u) | time min %u ms, max %u ms, avg %u ms\n",
+           seek.count, seek.found, seek.failed, seek.cancelled, seek.minTime, seek.maxTime,
+           (seek.found + seek.failed) ? (unsigned)(seek.totalTime / (seek.found + seek.failed)) : 0);
+
+    printf("\nFrequency: %u (device: %u)\n", rx.getFrequency(), rx.getRealFrequency());
+    rx.setFrequency(10650); // RDS comes only from the stations
+
+    // RDS FIFO (5 seconds of RDS)
+    sim.setRdsGroups(rdsGroups, sizeof(rdsGroups) / sizeof(si470x_rds_group));
+    rx.addRdsOdaHandler(SI470X_RDS_AID_RTPLUS, countOda);
+    rx.addRdsGroupHandler(SI470X_RDS_GROUP(1, 0), countGroup1A);
+    printf("\nRDS FIFO (%u groups), polling RDSR\n\n", SI470X_RDS_FIFO_SIZE);
+    rdsRun(rx, "rdsCapture every 20 ms", 20);
+    rdsRun(rx, "rdsCapture every 150 ms", 150);
+    delay(100);
+    MEASURE("processRdsGroup", rx.processRdsGroup());
+    MEASURE("getRdsStationName", rx.getRdsStationName());
+    MEASURE("getRdsProgramInformation", rx.getRdsProgramInformation());
+    showRds(rx);
+    if (rx.getRdsTime() != NULL)
+    {
+        printf("%-28s | UTC %s", "", rx.getRdsTime()); // Both use the same buffer
+        printf(" | local %s\n", rx.getRdsLocalDateTime());
+    }
+    {
+        uint8_t day, hour, minute;
+        printf("%-28s | PI 0x%04X | country 0x%X | ECC 0x%02X | same station %s", "",
+               rx.getRdsPi(), rx.getRdsCountryCode(), rx.getRdsEcc(), rx.isSameStation(0xE0F1) ? "yes" : "no");
+        if (rx.getRdsProgramItemNumber(&day, &hour, &minute))
+            printf(" | PIN day %u %02u:%02u", day, hour, minute);
+        printf("\n");
+
+        char pty[SI470X_RDS_PTY_NAME_SIZE], other[SI470X_RDS_PTY_NAME_SIZE];
+        printf("%-28s | PTY \"%s\" | PTYN \"%s\" | PTY 10 \"%s\" | PTY 14 \"%s\"\n", "",
+               rx.getRdsProgramTypeName(pty) ? pty : "", rx.getRdsProgramTypeNameText() ? rx.getRdsProgramTypeNameText() : "",
+               SI470X::getRdsProgramTypeNameP(10), SI470X::getRdsProgramTypeName(14, other));
+
+        const char *title, *artist;
+        uint8_t titleLength, artistLength;
+        if (rx.getRdsRtPlus(SI470X_RTPLUS_ITEM_TITLE, &title, &titleLength) && rx.getRdsRtPlus(SI470X_RTPLUS_ITEM_ARTIST, &artist, &artistLength))
+            printf("%-28s | RT+ title \"%.*s\" | artist \"%.*s\" | running %u\n", "", titleLength, title, artistLength, artist,
+                   rx.isRdsRtPlusItemRunning());
+
+        uint8_t oda = rx.getRdsOdaGroup(SI470X_RDS_AID_RTPLUS);
+        printf("%-28s | ODA 0x%04X in group %u%c: %u groups (3A included) | 1A handler: %u groups\n", "", SI470X_RDS_AID_RTPLUS,
+               oda >> 1, 'A' + (oda & 1), odaGroups, group1Groups);
+        rx.removeRdsHandler(countOda);
+        rx.removeRdsHandler(countGroup1A);
+    }
+
+    // Verbose mode: the device also delivers groups with errors
+    printf("\nRDS block error threshold (verbose mode)\n\n");
+    int thresholds[] = {3, 2, 1};
+    for (int i = 0; i < 3; i++)
+    {
+        char name[32];
+        sprintf(name, "threshold %d", thresholds[i]);
+        rx.clearRdsBuffer();
+        rx.resetRdsBlockStats();
+        rx.setRdsErrorThreshold(thresholds[i]);
+        rx.setRdsMode(RDS_VERBOSE);
+        rdsRun(rx, name, 20);
+        showRds(rx);
+    }
+    rx.clearRdsBuffer();
+    rx.resetRdsBlockStats();
+    rx.setRdsErrorThreshold(3);
+    rx.setRdsStationNameConfirm(true); // "2C" and "##" alternate on segment 1: the name is never published
+    rdsRun(rx, "threshold 3 + PS confirm", 20);
+    showRds(rx);
+    rx.setRdsStationNameConfirm(false);
+    rx.setRdsErrorThreshold(2);
+
+    // Reception statistics: no extra I2C traffic, everything comes from the decoder and the status reads
+    printf("\nRDS statistics (verbose mode, threshold 2)\n\n");
+    rx.resetRdsStats();
+    rdsRun(rx, "rdsCapture every 20 ms", 20);
+    {
+        si470x_rds_stats stats = rx.getRdsStats();
+        printf("%-28s | %u groups (%u valid) | %u.%u groups/s | last valid %u ms ago | sync losses %u\n", "",
+               (unsigned)stats.groups, (unsigned)stats.validGroups, stats.groupRate / 10, stats.groupRate % 10,
+               (unsigned)stats.lastValidAge, stats.syncLosses);
+        printf("%-28s | types:", "");
+        for (int i = 0; i < 16; i++)
+            if (stats.groupTypes[i] != 0)
+                printf(" %d:%u", i, stats.groupTypes[i]);
+        printf(" (version B %u)\n%-28s | BLER A..D (0/1/2/3):", stats.versionB, "");
+        for (int i = 0; i < 4; i++)
+            printf(" %u/%u/%u/%u", stats.bler[i][0], stats.bler[i][1], stats.bler[i][2], stats.bler[i][3]);
+        printf("\n");
+    }
+
+    // Binary recorder: the raw groups (with the block errors) are recorded and decoded again without the device
+    printf("\nRDS recorder (%d bytes per group)\n\n", SI470X_RDS_RECORD_SIZE);
+    rx.setRdsRecorder(recordGroup);
+    rdsRun(rx, "rdsCapture every 20 ms", 20);
+    rx.setRdsRecorder(NULL);
+    printf("%-28s | %u groups | %u bytes\n", "recorded", (unsigned)(recordingSize / SI470X_RDS_RECORD_SIZE), (unsigned)recordingSize);
+    {
+        SI470XRdsReplay replay(recording, recordingSize);
+        replayRds(replay, "replay");
+    }
+
+    // Callbacks: the sketch only does display work when the decoded content changes
+    printf("\nRDS callbacks\n\n");
+    rx.clearRdsBuffer();
+    rx.onProgramServiceChanged(showPs);
+    rx.onRadioTextChanged(showRt);
+    rx.onClockTime(showCt);
+    rx.onPtyChanged(showPty);
+    rdsRun(rx, "rdsCapture every 20 ms", 20);
+    printf("%-28s | %d calls\n", "", rdsCallbacks);
+    rx.onProgramServiceChanged(NULL);
+    rx.onRadioTextChanged(NULL);
+    rx.onClockTime(NULL);
+    rx.onPtyChanged(NULL);
+
+    // RDS cache: the station name is shown by the first group of a station listened to before
+    printf("\nRDS cache (%d stations)\n\n", SI470X_RDS_CACHE_SIZE);
+    rx.clearRdsBuffer();
+    rx.clearRdsCache();
+    timeToName(rx, "time to name, first time", 9750);
+    timeToName(rx, "time to name, cached", 10650); // The simulated stations share the same PI code
+
+    // AF follow: the signal of 106.5 MHz fades. 97.5 MHz carries the same station.
+    printf("\nAF follow (RSSI threshold %d)\n\n", SI470X_AF_RSSI_THRESHOLD);
+    for (unsigned long start = millis(); (millis() - start) < 300;) // PI confirmed
+    {
+        si470x_rds_group group;
+        delay(20);
+        rx.rdsCapture();
+        while (rx.getRdsGroup(&group))
+            rx.processRdsGroup(&group);
+    }
+    printf("%-28s |", "AF list");
+    for (uint8_t i = 0; i < rx.getRdsAfCount(); i++)
+        printf(" %u", rx.getRdsAf(i));
+    printf(" (method %c)\n", rx.isRdsAfMethodB() ? 'B' : 'A');
+    rx.setRdsAfFollow(true);
+    stations[3].rssi = 12;
+    {
+        si470x_bus_stats before = rx.getBusStats();
+        unsigned long start = millis(), muted = 0, longest = 0;
+        uint32_t polls = 0;
+        bool switched = false;
+        while ((millis() - start) < 3000 && !switched)
+        {
+            unsigned long t = micros();
+            rx.poll(); // The AF follow mode runs from poll(), one step per call
+            switched = rx.getFrequency() != 10650 && !rx.isRdsAfSearching();
+            if (micros() - t > longest)
+                longest = micros() - t;
+            if (rx.isRdsAfSearching())
+                muted++;
+            polls++;
+            delay(1);
+        }
+        while (rx.isRdsAfSearching())
+        {
+            rx.poll();
+            delay(1);
+        }
+        si470x_bus_stats after = rx.getBusStats();
+        printf("%-28s | %s %u | muted %lu ms | %u wr | %u rd | %u polls (longest %lu us) | PS \"%s\"\n", "AF follow (poll)",
+               switched ? "switched to" : "stayed on", rx.getFrequency(), muted,
+               after.writeTransactions - before.writeTransactions, after.readTransactions - before.readTransactions,
+               (unsigned)polls, longest, rx.getRdsStationName() ? rx.getRdsStationName() : "");
+    }
+    stations[3].rssi = 52;
+    rx.setRdsAfFollow(false);
+
+    // Traffic mode: 106.5 MHz announces traffic on the other network 0xE0F2 (103.9 MHz). It ends after 3 s.
+    printf("\nTraffic mode (EON)\n\n");
+    rx.setFrequency(10650);
+    rx.clearRdsBuffer();
+    rx.onTrafficAnnouncement(showTrafficAnnouncement);
+    rx.setRdsTrafficMode(true);
+    {
+        si470x_rds_group group;
+        unsigned long start = millis(), end = 0;
+        while ((millis() - start) < 8000)
+        {
+            delay(20);
+            rx.rdsCapture();
+            while (rx.getRdsGroup(&group))
+                rx.processRdsGroup(&group);
+            rx.poll();
+            if (end == 0 && rx.isRdsTrafficSwitched())
+                end = millis() + 3000;
+            if (end != 0 && millis() >= end)
+            {
+                for (uint8_t i = 0; i < sizeof(trafficGroups) / sizeof(si470x_rds_group); i++)
+                    trafficGroups[i].blockB &= ~0x0010; // TA = 0
+                rdsGroups[EON_TA_GROUP].blockB &= ~0x0008; // TA of the other network = 0
+            }
+        }
+        printf("%-28s | %u | PS \"%s\"\n", "back (tuned by poll)", rx.getFrequency(), rx.getRdsStationName() ? rx.getRdsStationName() : "");
+        for (uint8_t i = 0; i < rx.getRdsEonCount(); i++)
+            printf("%-28s | PI 0x%04X | %u | TP %u | TA %u\n", "EON", rx.getRdsEon(i)->pi, 8750 + rx.getRdsEon(i)->af * 10,
+                   rx.getRdsEon(i)->tp, rx.getRdsEon(i)->ta);
+    }
+    rx.setRdsTrafficMode(false);
+    rx.onTrafficAnnouncement(NULL);
+
+    // Same tune with GPIO2 connected to an interrupt pin: no status polling while tuning
+    {
+        SI470X rxi;
+
+        sim.setInterruptPin(SIM_GPIO2_PIN);
+        rxi.setBus(bus);
+        rxi.setup(0, -1, SIM_GPIO2_PIN, SIM_GPIO2_PIN);
+        printf("\nSTC and RDS interrupt on GPIO2\n\n");
+        asyncTune(rxi, "setFrequencyAsync + poll", 9750);
+        asyncTune(rxi, "setFrequencyAsync + poll", 10650);
+        rxi.setRds(true);
+        rdsRun(rxi, "rdsCapture every 20 ms", 20);
+        rdsRun(rxi, "rdsCapture every 150 ms", 150);
+        printf("%-28s | %u GPIO2 pulses\n", "", sim.interrupts);
+    }
+
+    return 0;
+}
@@ -0,0 +1,1128 @@
+/*
+   Regression tests of the SI470X library. They run on a host computer (Linux or macOS) against the
+   simulated device (SI470XSim) and recorded RDS groups (SI470XRdsReplay). No radio is needed.
+
+   It is not an Arduino sketch. Build and run it with "make test" (see the Makefile in this folder) or:
+
+   g++ -O2 -I ../../src si470x_host_tests.cpp ../../src/SI470X.cpp ../../src/SI470XHost.cpp ../../src/SI470XSim.cpp ../../src/SI470XLinuxBus.cpp -o si470x_host_tests
+
+   It prints the failed checks and exits with 1 if any check fails.
+
+   By Ricardo Lima Caratti, 2020.
+*/
+
+#include <stdio.h>
+#include <SI470X.h>
+#include <SI470XSim.h>
+
+#define CHECK(condition) check((condition), #condition, __FILE__, __LINE__)
+
+int checks = 0, failures = 0;
+
+void check(bool ok, const char *text, const char *file, int line)
+{
+    checks++;
+    if (ok)
+        return;
+    failures++;
+    printf("  FAILED %s:%d: %s\n", file, line, text);
+}
+
+bool same(const char *text, const char *expected)
+{
+    return text != NULL && strcmp(text, expected) == 0;
+}
+
+// Station X. PI 0xE0F1, PS "PU2CLR  ", RT "Hi PU2CLR", AF list (method A): 102.5, 97.5 and 106.5 MHz
+si470x_rds_group groupsX[] = {
+    {0xE0F1, 0x0400, 0xE396, 0x5055, 0}, // 0A, segment 0: "PU", AF: 3 frequencies follow, 102.5 MHz
+    {0xE0F1, 0x2400, 0x4869, 0x2050, 0}, // 2A, segment 0: "Hi P"
+    {0xE0F1, 0x0401, 0x64BE, 0x3243, 0}, // 0A, segment 1: "2C", AF: 97.5 MHz, 106.5 MHz
+    {0xE0F1, 0x2401, 0x5532, 0x434C, 0}, // 2A, segment 1: "U2CL"
+    {0xE0F1, 0x0402, 0xE396, 0x4C52, 0}, // 0A, segment 2: "LR"
+    {0xE0F1, 0x2402, 0x520D, 0x2020, 0}, // 2A, segment 2: "R\r  "
+    {0xE0F1, 0x0403, 0x64BE, 0x2020, 0}, // 0A, segment 3: "  "
+    {0xE0F1, 0x4001, 0xCE07, 0x7B42, 0}, // 4A: MJD 59139 (2020-10-17), 23:45 UTC, +01:00
+    {0xE0F1, 0xA000, 0x466F, 0x6F74, 0}, // 10A, segment 0: PTYN "Foot"
+    {0xE0F1, 0xA001, 0x6261, 0x6C6C, 0}, // 10A, segment 1: PTYN "ball"
+    {0xE0F1, 0x3016, 0x0000, 0x4BD7, 0}, // 3A: RadioText Plus (AID 0x4BD7) in the group 11A
+    {0xE0F1, 0xB008, 0x818A, 0x0801, 0}  // 11A: RT+ item running, ARTIST = RT[3..8] ("PU2CLR"), TITLE = RT[0..1] ("Hi")
+};
+
+// Station Y. PI 0xD001, only radio text (2A): "Only text"
+si470x_rds_group groupsY[] = {
+    {0xD001, 0x2400, 0x4F6E, 0x6C79, 0}, // 2A, segment 0: "Only"
+    {0xD001, 0x2401, 0x2074, 0x6578, 0}, // 2A, segment 1: " tex"
+    {0xD001, 0x2402, 0x740D, 0x2020, 0}  // 2A, segment 2: "t\r  "
+};
+
+// Station Z. PI 0xC0DE, PS "ZULU FM "
+si470x_rds_group groupsZ[] = {
+    {0xC0DE, 0x0400, 0xE0CD, 0x5A55, 0}, // 0A, segment 0: "ZU"
+    {0xC0DE, 0x0401, 0xE0CD, 0x4C55, 0}, // 0A, segment 1: "LU"
+    {0xC0DE, 0x0402, 0xE0CD, 0x2046, 0}, // 0A, segment 2: " F"
+    {0xC0DE, 0x0403, 0xE0CD, 0x4D20, 0}  // 0A, segment 3: "M "
+};
+
+// Station X with EON: PS "PU2CLR  " and traffic announced on the other network 0xE0F2 (103.9 MHz)
+si470x_rds_group groupsXEon[] = {
+    {0xE0F1, 0x0400, 0xE0CD, 0x5055, 0}, // 0A, segment 0: "PU"
+    {0xE0F1, 0x0401, 0xE0CD, 0x3243, 0}, // 0A, segment 1: "2C"
+    {0xE0F1, 0x0402, 0xE0CD, 0x4C52, 0}, // 0A, segment 2: "LR"
+    {0xE0F1, 0x0403, 0xE0CD, 0x2020, 0}, // 0A, segment 3: "  "
+    {0xE0F1, 0xE015, 0xBEA4, 0xE0F2, 0}, // 14A, variant 5: 106.5 MHz is mapped to 103.9 MHz on the other network 0xE0F2 (TP = 1)
+    {0xE0F1, 0xE818, 0xE0F1, 0xE0F2, 0}  // 14B: traffic announcement on the other network 0xE0F2 (see EON_TA_GROUP)
+};
+#define EON_TA_GROUP 5
+
+// Traffic station T (EON linked to X). PI 0xE0F2, PS "TRAFFIC ", TP = 1 and TA = 1
+si470x_rds_group groupsT[] = {
+    {0xE0F2, 0x0410, 0xE0CD, 0x5452, 0}, // 0A, segment 0: "TR"
+    {0xE0F2, 0x0411, 0xE0CD, 0x4146, 0}, // 0A, segment 1: "AF"
+    {0xE0F2, 0x0412, 0xE0CD, 0x4649, 0}, // 0A, segment 2: "FI"
+    {0xE0F2, 0x0413, 0xE0CD, 0x4320, 0}  // 0A, segment 3: "C "
+};
+
+// Channels: band 0 (87.5 MHz) and 100 kHz space (setup default)
+#define CH_9200 45  // No station
+#define CH_9750 100
+#define CH_9800 105
+#define CH_10250 150
+#define CH_10390 164
+#define CH_10650 190
+
+si470x_sim_station stations[] = {
+    {CH_9750, 45, groupsX, sizeof(groupsX) / sizeof(si470x_rds_group)},  // 97.5 MHz: X (alternative frequency)
+    {CH_9800, 40, groupsY, sizeof(groupsY) / sizeof(si470x_rds_group)},  // 98.0 MHz: Y
+    {CH_10250, 50, groupsZ, sizeof(groupsZ) / sizeof(si470x_rds_group)}, // 102.5 MHz: Z (in the AF list of X, but another station)
+    {CH_10650, 52, groupsX, sizeof(groupsX) / sizeof(si470x_rds_group)}  // 106.5 MHz: X
+};
+const uint8_t stationRssi[] = {45, 40, 50, 52};
+#define ST_9750 0
+#define ST_10650 3
+
+si470x_sim_station trafficStations[] = {
+    {CH_10390, 40, groupsT, sizeof(groupsT) / sizeof(si470x_rds_group)},        // 103.9 MHz: T
+    {CH_10650, 52, groupsXEon, sizeof(groupsXEon) / sizeof(si470x_rds_group)} // 106.5 MHz: X with EON
+};
+
+SI470XSim sim;
+
+// Worst poll() seen by run(): I2C transactions and time
+uint32_t maxPollTransactions = 0;
+unsigned long maxPollTime = 0;
+// Most I2C writes seen in one processRdsGroup() call (the RDS decoder must not tune)
+uint32_t maxDecoderWrites = 0;
+
+/**
+ * Starts a test: simulated device in its initial state and receiver tuned on 106.5 MHz with RDS on
+ */
+void begin(SI470X &rx, const char *name)
+{
+    printf("%s\n", name);
+    for (uint8_t i = 0; i < sizeof(stations) / sizeof(si470x_sim_station); i++)
+        stations[i].rssi = stationRssi[i];
+    sim.reset();
+    sim.setStations(stations, sizeof(stations) / sizeof(si470x_sim_station));
+    sim.setRdsGroups(NULL, 0);
+    rx.setBus(&sim);
+    rx.setup(0, -1);
+    rx.setRds(true);
+    rx.setFrequency(10650);
+}
+
+/**
+ * Runs a sketch loop for "ms" milliseconds: poll() and the RDS decoder every 5 ms.
+ * Each poll() is measured (see maxPollTransactions and maxPollTime).
+ */
+void run(SI470X &rx, unsigned long ms)
+{
+    for (unsigned long start = millis(); (millis() - start) < ms;)
+    {
+        si470x_bus_stats before = rx.getBusStats(), after;
+        unsigned long t = micros();
+
+        rx.poll();
+        after = rx.getBusStats();
+        uint32_t transactions = (after.readTransactions - before.readTransactions) + (after.writeTransactions - before.writeTransactions);
+        if (transactions > maxPollTransactions)
+            maxPollTransactions = transactions;
+        if (micros() - t > maxPollTime)
+            maxPollTime = micros() - t;
+
+        before = rx.getBusStats();
+        rx.processRdsGroup();
+        after = rx.getBusStats();
+        if (after.writeTransactions - before.writeTransactions > maxDecoderWrites)
+            maxDecoderWrites = after.writeTransactions - before.writeTransactions;
+        delay(5);
+    }
+}
+
+/**
+ * Converts groups to the recorder format (see SI470X::setRdsRecorder), 88 ms apart
+ */
+size_t record(const si470x_rds_group *groups, size_t count, uint8_t *recording)
+{
+    for (size_t i = 0; i < count; i++)
+        SI470X::encodeRdsRecord(&groups[i], 88, recording + i * SI470X_RDS_RECORD_SIZE);
+    return count * SI470X_RDS_RECORD_SIZE;
+}
+
+void testDecoder()
+{
+    SI470X rx;
+    uint8_t recording[sizeof(groupsX) / sizeof(si470x_rds_group) * 2 * SI470X_RDS_RECORD_SIZE];
+    size_t size = record(groupsX, sizeof(groupsX) / sizeof(si470x_rds_group), recording);
+    SI470XRdsReplay replay;
+    si470x_rds_clock_time ct;
+    const char *text;
+    uint8_t length;
+
+    printf("RDS decoder (replay)\n");
+    size += record(groupsX, sizeof(groupsX) / sizeof(si470x_rds_group), recording + size); // The RT+ tags refer to the complete text
+    replay.setRecording(recording, size);
+    rx.clearRdsBuffer();
+    CHECK(replay.decode(rx) == 2 * sizeof(groupsX) / sizeof(si470x_rds_group));
+
+    CHECK(same(rx.getRdsStationName(), "PU2CLR  "));
+    CHECK(same(rx.getRdsProgramInformation(), "Hi PU2CLR"));
+    CHECK(rx.getRdsStationInformation() == NULL);
+    CHECK(same(rx.getRdsProgramTypeNameText(), "Football"));
+
+    CHECK(rx.getRdsClockTime(&ct));
+    CHECK(ct.year == 2020 && ct.month == 10 && ct.day == 17 && ct.hour == 23 && ct.minute == 45 && ct.offset == 2);
+    CHECK(rx.getRdsClockTime(&ct, true));
+    CHECK(ct.year == 2020 && ct.month == 10 && ct.day == 18 && ct.hour == 0 && ct.minute == 45 && ct.offset == 0);
+
+    CHECK(rx.getRdsOdaGroup(SI470X_RDS_AID_RTPLUS) == SI470X_RDS_GROUP(11, 0));
+    CHECK(rx.getRdsRtPlus(SI470X_RTPLUS_ITEM_TITLE, &text, &length) && length == 2 && strncmp(text, "Hi", 2) == 0);
+    CHECK(rx.getRdsRtPlus(SI470X_RTPLUS_ITEM_ARTIST, &text, &length) && length == 6 && strncmp(text, "PU2CLR", 6) == 0);
+    CHECK(rx.isRdsRtPlusItemRunning());
+
+    CHECK(rx.getRdsAfCount() == 3);
+    CHECK(rx.getRdsAf(0) == 10250 && rx.getRdsAf(1) == 9750 && rx.getRdsAf(2) == 10650);
+}
+
+void testRtPlusGroup()
+{
+    SI470X rx;
+    si470x_rds_group in2A = {0xE0F1, 0x3004, 0x0000, SI470X_RDS_AID_RTPLUS, 0};  // 3A with a corrupted block B: RT+ in the group 2A
+    si470x_rds_group fault = {0xE0F1, 0x301F, 0x0000, SI470X_RDS_AID_RTPLUS, 0}; // 3A: 15B (temporary data fault)
+
+    printf("RT+ group announcement\n");
+    rx.clearRdsBuffer();
+    rx.processRdsGroup(&fault);
+    rx.processRdsGroup(&in2A);
+    CHECK(!rx.isRdsRtPlus());
+    for (uint8_t i = 0; i < sizeof(groupsX) / sizeof(si470x_rds_group); i++)
+        rx.processRdsGroup(&groupsX[i]);
+    CHECK(same(rx.getRdsStationName(), "PU2CLR  "));
+    CHECK(same(rx.getRdsProgramInformation(), "Hi PU2CLR"));
+    CHECK(rx.getRdsOdaGroup(SI470X_RDS_AID_RTPLUS) == SI470X_RDS_GROUP(11, 0));
+    rx.processRdsGroup(&fault);
+    CHECK(rx.getRdsOdaGroup(SI470X_RDS_AID_RTPLUS) == SI470X_RDS_GROUP(11, 0));
+}
+
+void testStationName()
+{
+    SI470X rx;
+    si470x_rds_group news[] = {
+        {0xC0DE, 0x0400, 0xE0CD, 0x4E45, 0}, // 0A, segment 0: "NE"
+        {0xC0DE, 0x0401, 0xE0CD, 0x5753, 0}, // 0A, segment 1: "WS"
+        {0xC0DE, 0x0402, 0xE0CD, 0x2046, 0}, // 0A, segment 2: " F"
+        {0xC0DE, 0x0403, 0xE0CD, 0x4D20, 0}  // 0A, segment 3: "M "
+    };
+    uint8_t version;
+
+    printf("station name\n");
+    rx.clearRdsBuffer();
+    version = rx.getRdsStationNameVersion();
+    for (uint8_t i = 0; i < 3; i++)
+        rx.processRdsGroup(&groupsZ[i]);
+    CHECK(rx.getRdsStationName() == NULL); // Published only with the four segments
+    rx.processRdsGroup(&groupsZ[3]);
+    CHECK(same(rx.getRdsStationName(), "ZULU FM "));
+    CHECK(rx.getRdsStationNameVersion() == (uint8_t)(version + 1));
+    for (uint8_t i = 0; i < 4; i++)
+        rx.processRdsGroup(&groupsZ[i]);
+    CHECK(rx.getRdsStationNameVersion() == (uint8_t)(version + 1)); // Same name: no redraw
+
+    // A new name: the previous one stays until the new one is complete
+    for (uint8_t i = 0; i < 3; i++)
+        rx.processRdsGroup(&news[i]);
+    CHECK(same(rx.getRdsStationName(), "ZULU FM "));
+    rx.processRdsGroup(&news[3]);
+    CHECK(same(rx.getRdsStationName(), "NEWS FM "));
+    CHECK(rx.getRdsStationNameVersion() == (uint8_t)(version + 2));
+
+    // Confirmation: each segment must be received twice with the same content
+    rx.setRdsStationNameConfirm(true);
+    for (uint8_t i = 0; i < 4; i++)
+        rx.processRdsGroup(&groupsZ[i]);
+    CHECK(same(rx.getRdsStationName(), "NEWS FM "));
+    for (uint8_t i = 0; i < 4; i++)
+        rx.processRdsGroup(&groupsZ[i]);
+    CHECK(same(rx.getRdsStationName(), "ZULU FM "));
+    CHECK(rx.getRdsStationNameVersion() == (uint8_t)(version + 3));
+}
+
+/**
+ * Builds a group 4A (clock time). offset in half hours.
+ */
+si470x_rds_group clockGroup(uint32_t mjd, uint8_t hour, uint8_t minute, int8_t offset)
+{
+    si470x_rds_group group = {0xE0F1, 0, 0, 0, 0};
+
+    group.blockB = 0x4000 | ((mjd >> 15) & 0x03);
+    group.blockC = ((mjd & 0x7FFF) << 1) | (hour >> 4);
+    group.blockD = ((hour & 0x0F) << 12) | (minute << 6) | ((offset < 0) ? 0x20 : 0) | ((offset < 0) ? -offset : offset);
+    return group;
+}
+
+bool sameTime(const si470x_rds_clock_time &ct, uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute)
+{
+    return ct.year == year && ct.month == month && ct.day == day && ct.hour == hour && ct.minute == minute;
+}
+
+void testClockTime()
+{
+    SI470X rx;
+    si470x_rds_clock_time ct;
+    si470x_rds_group group;
+    uint8_t version;
+
+    printf("clock time\n");
+    rx.clearRdsBuffer();
+    CHECK(!rx.getRdsClockTime(&ct));
+
+    group = clockGroup(59214, 23, 30, 4); // 2020-12-31 23:30 UTC, +02:00: next year in local time
+    rx.processRdsGroup(&group);
+    CHECK(rx.getRdsClockTime(&ct) && sameTime(ct, 2020, 12, 31, 23, 30) && ct.offset == 4);
+    CHECK(rx.getRdsClockTime(&ct, true) && sameTime(ct, 2021, 1, 1, 1, 30) && ct.offset == 0);
+
+    group = clockGroup(59274, 1, 0, -10); // 2021-03-01 01:00 UTC, -05:00: previous month in local time
+    rx.processRdsGroup(&group);
+    CHECK(rx.getRdsClockTime(&ct, true) && sameTime(ct, 2021, 2, 28, 20, 0));
+
+    group = clockGroup(58907, 23, 0, 4); // 2020-02-28 23:00 UTC, +02:00: leap day
+    rx.processRdsGroup(&group);
+    CHECK(rx.getRdsClockTime(&ct, true) && sameTime(ct, 2020, 2, 29, 1, 0));
+
+    version = rx.getRdsClockTimeVersion();
+    group = clockGroup(58907, 24, 0, 0); // Invalid hour: ignored
+    rx.processRdsGroup(&group);
+    CHECK(rx.getRdsClockTimeVersion() == version);
+    CHECK(rx.getRdsClockTime(&ct) && sameTime(ct, 2020, 2, 28, 23, 0));
+}
+
+void testRadioText()
+{
+    SI470X rx;
+    si470x_rds_group bad = {0xD001, 0x2401, 0x200D, 0x6578, 0};   // 2A, segment 1 with a corrupted character taken as 0x0D: " \rex"
+    si470x_rds_group textB = {0xD001, 0x2410, 0x4279, 0x650D, 0}; // 2A, text B, segment 0: "Bye\r"
+    si470x_rds_group empty = {0xD001, 0x2400, 0x0D20, 0x2020, 0}; // 2A, text A, segment 0: "\r   "
+
+    printf("radio text\n");
+    rx.clearRdsBuffer();
+    rx.processRdsGroup(&groupsY[0]);
+    rx.processRdsGroup(&bad);
+#if SI470X_RDS_RT_WORK // Without the work buffer, the text shows up as it arrives
+    CHECK(same(rx.getRdsProgramInformation(), "Only "));
+#endif
+    for (uint8_t i = 0; i < sizeof(groupsY) / sizeof(si470x_rds_group); i++)
+        rx.processRdsGroup(&groupsY[i]);
+    CHECK(same(rx.getRdsProgramInformation(), "Only text")); // The next repetition is complete again
+
+    rx.processRdsGroup(&textB); // A/B toggle: new message
+    CHECK(same(rx.getRdsProgramInformation(), "Bye"));
+    rx.processRdsGroup(&groupsY[1]); // Text A again: the segment 0 is still missing
+#if SI470X_RDS_RT_WORK
+    CHECK(same(rx.getRdsProgramInformation(), "Bye"));
+#endif
+    rx.processRdsGroup(&empty);
+    CHECK(rx.getRdsProgramInformation() == NULL); // Emptied by the station
+}
+
+int group8A = 0, odaGroups = 0;
+
+void countGroup8A(const si470x_rds_group *group, uint8_t valid)
+{
+    (void)group;
+    (void)valid;
+    group8A++;
+}
+
+void countOda(const si470x_rds_group *group, uint8_t valid)
+{
+    (void)group;
+    (void)valid;
+    odaGroups++;
+}
+
+void testRdsHandlers()
+{
+    SI470X rx;
+    si470x_rds_group noAid = {0xE0F1, 0x3012, 0x0000, 0x0000, 0}; // 3A: group 9A, AID 0 (no application)
+    si470x_rds_group oda = {0xE0F1, 0x3012, 0x0000, 0xCD46, 0};   // 3A: group 9A, AID 0xCD46 (TMC)
+    si470x_rds_group g8A = {0xE0F1, 0x8000, 0x0000, 0x0000, 0};
+    si470x_rds_group g9A = {0xE0F1, 0x9000, 0x0000, 0x0000, 0};
+
+    printf("RDS handlers\n");
+    rx.clearRdsBuffer();
+    CHECK(rx.addRdsGroupHandler(SI470X_RDS_GROUP(8, 0), countGroup8A));
+    CHECK(rx.addRdsOdaHandler(0xCD46, countOda));
+
+    rx.processRdsGroup(&noAid); // Must not bind the fixed group handler to 9A
+    rx.processRdsGroup(&g8A);
+    rx.processRdsGroup(&g9A);
+    CHECK(group8A == 1);
+    CHECK(odaGroups == 0);
+    CHECK(rx.getRdsOdaGroup(0xCD46) == SI470X_RDS_NO_GROUP);
+
+    rx.processRdsGroup(&oda); // Binds only the ODA handler (it also receives the group 3A)
+    rx.processRdsGroup(&g8A);
+    rx.processRdsGroup(&g9A);
+    CHECK(group8A == 2);
+    CHECK(odaGroups == 2);
+    CHECK(rx.getRdsOdaGroup(0xCD46) == SI470X_RDS_GROUP(9, 0));
+}
+
+void testLayoutCheck()
+{
+    SI470X rx;
+    si470x_bus_stats before = rx.getBusStats();
+
+    printf("layout check\n");
+    sim.reset();
+    rx.setBus(&sim);
+    rx.setup(0, -1, -1, -1, OSCILLATOR_TYPE_CRYSTAL, sizeof(SI470X) - 2); // As if the sketch had defined a configuration macro
+    CHECK(rx.getBusStats().writeTransactions == before.writeTransactions);
+    CHECK(!(sim.getRegister(REG02) & 0x0001)); // ENABLE: not powered up
+    rx.setup(0, -1);
+    CHECK(sim.getRegister(REG02) & 0x0001);
+}
+
+void testDirtyRegisters()
+{
+    SI470X rx;
+    si470x_bus_stats stats;
+
+    begin(rx, "dirty registers");
+    CHECK(rx.getDirtyRegisters() == 0);
+    rx.resetBusStats();
+    rx.setVolume(rx.getVolume()); // Nothing changed: the bus is not used
+    stats = rx.getBusStats();
+    CHECK(stats.writeTransactions == 0 && stats.bytesWritten == 0);
+    CHECK(stats.bytesSaved == 12);
+
+    rx.resetBusStats();
+    rx.setVolume(rx.getVolume() == 15 ? 14 : 15); // 0x05: from 0x02 to 0x05
+    stats = rx.getBusStats();
+    CHECK(stats.writeTransactions == 1 && stats.bytesWritten == 8);
+    CHECK(stats.bytesSaved == 4);
+    CHECK((sim.getRegister(REG05) & 0x000F) == rx.getVolume());
+    CHECK(rx.getDirtyRegisters() == 0);
+
+    rx.resetBusStats();
+    rx.setMono(true); // 0x02 only
+    stats = rx.getBusStats();
+    CHECK(stats.writeTransactions == 1 && stats.bytesWritten == 2);
+    CHECK(stats.bytesSaved == 10);
+    CHECK(sim.getRegister(REG02) & 0x2000);
+}
+
+#if defined(__linux__)
+void testLinuxBus()
+{
+    SI470X rx;
+    SI470XSimLinuxBus bus(&sim);
+    SI470XLinuxBus missing("/dev/i2c-si470x-missing");
+    uint8_t data[2] = {0, 0};
+
+    printf("Linux i2c-dev transport (stand-in)\n");
+    sim.reset();
+    sim.setStations(stations, sizeof(stations) / sizeof(si470x_sim_station));
+    rx.setBus(&bus);
+    rx.setup(0, -1);
+    CHECK(rx.getManufacturerId() != 0 && rx.getManufacturerId() == (sim.getRegister(REG00) & 0x0FFF)); // 0x00: the 7th register sent
+
+    // The write that clears TUNE and the following status read go in one kernel call
+    sim.resetCounters();
+    bus.kernelCalls = 0;
+    rx.setFrequency(10250);
+    CHECK(sim.getRegister(REG03) == CH_10250);
+    CHECK(rx.getRealFrequency() == 10250); // READCHAN: the second register sent (0x0A, 0x0B, ...)
+    CHECK(bus.kernelCalls == sim.readTransactions + sim.writeTransactions - 1);
+
+    missing.begin(); // No such adapter: every transfer fails
+    CHECK(missing.getFd() < 0);
+    CHECK(missing.write(I2C_DEVICE_ADDR, data, 2) != 0);
+    CHECK(missing.read(I2C_DEVICE_ADDR, data, 2) == 0);
+    CHECK(missing.probe(I2C_DEVICE_ADDR) != 0);
+}
+#endif
+
+void testPartialReads()
+{
+    SI470X rx;
+    si470x_bus_stats stats;
+
+    begin(rx, "partial register reads");
+    rx.resetBusStats();
+    rx.getRssi(); // 0x0A
+    stats = rx.getBusStats();
+    CHECK(stats.readTransactions == 1 && stats.bytesRead == 2);
+
+    rx.resetBusStats();
+    CHECK(rx.getRealFrequency() == 10650); // 0x0A and 0x0B (READCHAN)
+    stats = rx.getBusStats();
+    CHECK(stats.readTransactions == 1 && stats.bytesRead == 4);
+
+    rx.resetBusStats();
+    rx.getRdsStatus(); // 0x0A to 0x0F
+    stats = rx.getBusStats();
+    CHECK(stats.readTransactions == 1 && stats.bytesRead == 12);
+
+    // Status read latency: only the transfer, no fixed wait after the request (see SI470X_READ_WAIT)
+    sim.setBusClock(400000);
+    rx.resetBusStats();
+    for (uint8_t i = 0; i < 10; i++)
+        rx.getRssi();
+    stats = rx.getBusStats();
+    CHECK(stats.readMicros / 10 < 100); // 3 bytes (address + 0x0A) at 400 kHz: 67 us
+    sim.setBusClock(SI470X_SIM_BUS_CLOCK);
+
+    rx.resetBusStats();
+    rx.setFrequency(9800); // Status and READCHAN only: no read of all the registers
+    stats = rx.getBusStats();
+    CHECK(stats.readTransactions > 0 && stats.bytesRead <= 4 * stats.readTransactions);
+    CHECK(rx.getFrequency() == 9800);
+}
+
+void testRdsMode()
+{
+    SI470X rx;
+
+    begin(rx, "RDS mode");
+    CHECK(sim.getRegister(REG02) & 0x0800); // RDSM: verbose, so the default error threshold (2) works
+    rx.setRds(false);
+    rx.setRdsMode(RDS_STANDARD);
+    rx.setRdsErrorThreshold(3); // All blocks accepted: no need for the verbose mode
+    rx.setRds(true);
+    CHECK(!(sim.getRegister(REG02) & 0x0800));
+}
+
+int seekProgress = 0;
+uint8_t seekEvent = SI470X_SEEK_EVENT_PROGRESS;
+uint16_t seekFrequency = 0, seekStopFrequency = 0;
+
+void recordSeekEvent(uint8_t event, uint16_t frequency)
+{
+    if (event == SI470X_SEEK_EVENT_PROGRESS)
+    {
+        seekProgress++;
+        return;
+    }
+    seekEvent = event;
+    seekFrequency = frequency;
+    seekStopFrequency = 8750 + (sim.getRegister(REG0B) & 0x03FF) * 10; // READCHAN when the event is sent
+}
+
+void testAsyncTune()
+{
+    SI470X rx;
+    si470x_bus_stats before, after;
+    unsigned long start;
+    uint32_t polls = 0;
+
+    begin(rx, "non-blocking tune");
+    start = millis();
+    rx.setFrequencyAsync(9800);
+    CHECK(millis() - start < 5); // Sets TUNE and returns
+    CHECK(!rx.isTuneComplete() && rx.getTuneState() == SI470X_TUNE_WAIT_STC);
+    CHECK(sim.getRegister(REG03) & 0x8000);
+    before = rx.getBusStats();
+    while (!rx.poll())
+    {
+        polls++;
+        delay(1);
+    }
+    after = rx.getBusStats();
+    CHECK(polls >= SI470X_TUNE_TIME); // The loop kept running while tuning
+    CHECK(after.readTransactions - before.readTransactions <= 3); // No status read during SI470X_TUNE_TIME
+    CHECK(after.writeTransactions - before.writeTransactions == 1); // TUNE cleared
+    CHECK(!(sim.getRegister(REG0A) & 0x4000)); // Idle only after STC is cleared
+    CHECK(rx.isTuneComplete() && rx.getFrequency() == 9800);
+    CHECK(sim.getRegister(REG03) == CH_9800);
+
+    rx.setFrequencyAsync(10250);
+    rx.setFrequencyAsync(9750); // Requested during a tune: the latest one wins
+    while (!rx.poll())
+        delay(1);
+    CHECK(rx.getFrequency() == 9750 && rx.getRealFrequency() == 9750);
+}
+
+void testSeekAsync()
+{
+    SI470X rx;
+    si470x_bus_stats before, after;
+    si470x_seek_stats stats;
+
+    begin(rx, "non-blocking seek");
+    rx.setFrequency(9200);
+    rx.setSeekEventHandler(recordSeekEvent);
+    rx.resetSeekStats();
+    seekProgress = 0;
+    seekEvent = SI470X_SEEK_EVENT_PROGRESS;
+    before = rx.getBusStats();
+    rx.seekAsync(SI470X_SEEK_WRAP, SI470X_SEEK_UP);
+    CHECK(rx.isSeeking());
+    while (!rx.poll())
+        delay(1);
+    after = rx.getBusStats();
+    CHECK(seekEvent == SI470X_SEEK_EVENT_FOUND && seekFrequency == 9750);
+    CHECK(seekProgress > 0); // READCHAN moving from 92.0 to 97.5 MHz
+    CHECK(after.writeTransactions - before.writeTransactions == 2); // SEEK set and cleared: no second tune
+    CHECK(rx.getFrequency() == 9750 && rx.getRealFrequency() == 9750);
+
+    rx.seekAsync(SI470X_SEEK_STOP, SI470X_SEEK_DOWN); // From 97.5 MHz: no station down to the band limit (87.5 MHz)
+    while (!rx.poll())
+        delay(1);
+    CHECK(seekEvent == SI470X_SEEK_EVENT_FAILED);
+
+    stats = rx.getSeekStats();
+    CHECK(stats.count == 2 && stats.found == 1 && stats.failed == 1 && stats.cancelled == 0);
+    CHECK(stats.minTime > 0 && stats.minTime <= stats.maxTime && stats.totalTime == (uint32_t)stats.minTime + stats.maxTime);
+    CHECK(stats.lastTime == stats.maxTime); // The band limit is farther
+    rx.setSeekEventHandler(NULL);
+}
+
+#define SIM_GPIO2_PIN 2 // Host "pin" connected to the simulated GPIO2
+
+void testStcInterrupt()
+{
+    SI470X rx;
+    si470x_bus_stats before, after;
+    uint32_t pulses;
+
+    printf("STC interrupt (GPIO2)\n");
+    sim.reset();
+    sim.setStations(stations, sizeof(stations) / sizeof(si470x_sim_station));
+    sim.setInterruptPin(SIM_GPIO2_PIN);
+    rx.setBus(&sim);
+    rx.setup(0, -1, -1, SIM_GPIO2_PIN);
+    CHECK(rx.isStcInterruptEnabled());
+    CHECK((sim.getRegister(REG04) & 0x4000) && (sim.getRegister(REG04) & 0x000C) == 0x0004); // STCIEN = 1, GPIO2 = 01
+
+    pulses = sim.interrupts;
+    rx.setFrequencyAsync(9800);
+    before = rx.getBusStats();
+    while (!rx.poll())
+        delay(1);
+    after = rx.getBusStats();
+    CHECK(sim.interrupts == pulses + 1);
+    CHECK(after.readTransactions - before.readTransactions <= 3); // Only after the pulse
+    CHECK(micros() - sim.stcTime < 5000);                         // Completion latency
+    CHECK(rx.getFrequency() == 9800 && sim.getRegister(REG03) == CH_9800);
+    sim.setInterruptPin(-1);
+}
+
+void testRdsFifo()
+{
+    SI470X rx;
+    si470x_rds_fifo_stats stats;
+    si470x_rds_group group;
+    uint32_t sent;
+
+    printf("RDS FIFO (GPIO2)\n");
+    sim.reset();
+    sim.setStations(stations, sizeof(stations) / sizeof(si470x_sim_station));
+    sim.setInterruptPin(SIM_GPIO2_PIN);
+    rx.setBus(&sim);
+    rx.setup(0, -1, SIM_GPIO2_PIN, SIM_GPIO2_PIN);
+    CHECK(rx.isRdsInterruptEnabled());
+    rx.setFrequency(10650);
+    rx.setRds(true);
+    CHECK(sim.getRegister(REG04) & 0x8000); // RDSIEN
+    rx.clearRdsFifo();
+    rx.resetRdsFifoStats();
+
+    // The loop captures every group but does not drain the FIFO
+    sent = sim.rdsGroupsSent;
+    for (unsigned long start = millis(); (millis() - start) < (SI470X_RDS_FIFO_SIZE + 4) * 88UL;)
+    {
+        rx.poll();
+        delay(5);
+    }
+    rx.poll(); // The group sent during the last delay, if any
+    stats = rx.getRdsFifoStats();
+    CHECK(stats.received == SI470X_RDS_FIFO_SIZE && rx.getRdsGroupCount() == SI470X_RDS_FIFO_SIZE);
+    CHECK(stats.maxUsed == SI470X_RDS_FIFO_SIZE);
+    CHECK(stats.dropped > 0 && stats.received + stats.dropped == sim.rdsGroupsSent - sent);
+    CHECK(stats.missed == 0);
+    CHECK(rx.getRdsGroup(&group) && group.blockA == 0xE0F1);
+    rx.clearRdsFifo();
+    CHECK(!rx.getRdsGroup(&group));
+
+    // The loop is busy for 4 groups: the device keeps only the latest one
+    rx.resetRdsFifoStats();
+    delay(4 * 88);
+    rx.poll();
+    stats = rx.getRdsFifoStats();
+    CHECK(stats.received == 1 && stats.missed >= 3);
+    sim.setInterruptPin(-1);
+}
+
+void testSeekCancel()
+{
+    SI470X rx;
+
+    begin(rx, "seek cancel");
+    rx.setFrequency(9200);
+    rx.setSeekEventHandler(recordSeekEvent);
+
+    // Cancelled by a new tune: the event reports where the seek stopped, not the new frequency
+    seekProgress = 0;
+    rx.seekAsync(SI470X_SEEK_WRAP, SI470X_SEEK_UP);
+    while (seekProgress < 3 && !rx.poll())
+        delay(1);
+    rx.setFrequencyAsync(9800);
+    CHECK(seekEvent == SI470X_SEEK_EVENT_CANCELLED);
+    CHECK(seekFrequency == seekStopFrequency);
+    CHECK(seekFrequency > 9200 && seekFrequency < 9750);
+    while (!rx.poll())
+        delay(1);
+    CHECK(rx.getFrequency() == 9800);
+
+    // Cancelled by cancelSeek: the receiver stays there
+    seekProgress = 0;
+    rx.seekAsync(SI470X_SEEK_WRAP, SI470X_SEEK_UP);
+    while (seekProgress < 2 && !rx.poll())
+        delay(1);
+    CHECK(rx.cancelSeek());
+    CHECK(seekEvent == SI470X_SEEK_EVENT_CANCELLED);
+    CHECK(seekFrequency == seekStopFrequency && seekFrequency > 9800 && seekFrequency < 10250);
+    while (!rx.poll())
+        delay(1);
+    CHECK(rx.getFrequency() == seekFrequency);
+    CHECK(rx.getRealFrequency() == seekFrequency);
+    rx.setSeekEventHandler(NULL);
+}
+
+void testSeekAfterTune()
+{
+    SI470X rx;
+    si470x_bus_stats before;
+    unsigned long start;
+
+    begin(rx, "seek requested during a tune");
+    rx.setFrequencyAsync(9200);
+    before = rx.getBusStats();
+    start = millis();
+    rx.seekAsync(SI470X_SEEK_WRAP, SI470X_SEEK_UP); // Queued: it does not wait for the tune
+    CHECK(rx.getBusStats().writeTransactions == before.writeTransactions);
+    CHECK(millis() - start < SI470X_TUNE_TIME);
+    CHECK(!rx.isTuneComplete());
+    while (!rx.poll())
+        delay(1);
+    CHECK(rx.getFrequency() == 9750); // From 92.0 MHz up to the first station
+    CHECK((sim.getRegister(REG0B) & 0x03FF) == CH_9750);
+
+    rx.setFrequencyAsync(9200);
+    rx.seekAsync(SI470X_SEEK_WRAP, SI470X_SEEK_UP);
+    rx.setFrequencyAsync(10250); // The latest request wins
+    while (!rx.poll())
+        delay(1);
+    CHECK(rx.getFrequency() == 10250);
+}
+
+void testRdsStats()
+{
+    SI470X rx;
+    si470x_rds_group errors = {0xE0F1, 0x0401, 0xE0CD, 0x2323, 0x13}; // 0A: BLERB = 1 (corrected), BLERD = 3 (uncorrectable)
+    si470x_rds_stats stats;
+    si470x_bus_stats before;
+    uint32_t groups = 0;
+
+    begin(rx, "RDS statistics");
+    rx.processRdsGroup(&errors);
+    stats = rx.getRdsStats();
+    CHECK(stats.groups == 1 && stats.validGroups == 0);
+    CHECK(stats.bler[0][0] == 1 && stats.bler[1][1] == 1 && stats.bler[2][0] == 1 && stats.bler[3][3] == 1);
+    CHECK(stats.groupTypes[0] == 1 && stats.versionB == 0);
+    CHECK(stats.lastValidAge == 0xFFFFFFFF);
+
+    rx.resetRdsStats();
+    run(rx, SI470X_RDS_RATE_WINDOW + 500);
+    before = rx.getBusStats();
+    stats = rx.getRdsStats();
+    CHECK(rx.getBusStats().readTransactions == before.readTransactions); // Nothing read from the device
+    for (uint8_t i = 0; i < 16; i++)
+        groups += stats.groupTypes[i];
+    CHECK(stats.groups > 20 && stats.validGroups == stats.groups && groups == stats.groups);
+    CHECK(stats.groupTypes[0] > 0 && stats.groupTypes[2] > 0 && stats.groupTypes[4] > 0);
+    CHECK(stats.bler[0][0] == stats.groups);
+    CHECK(stats.groupRate >= 100 && stats.groupRate <= 125); // Nominal 114 (11.4 groups per second)
+    CHECK(stats.lastValidAge < 200);
+    CHECK(stats.syncLosses == 0);
+
+    rx.setFrequency(9800); // Tuning loses the synchronization: not counted
+    run(rx, 500);
+    CHECK(rx.getRdsStats().syncLosses == 0);
+}
+
+uint8_t fieldRecording[64 * SI470X_RDS_RECORD_SIZE];
+size_t fieldSize = 0;
+
+void recordGroup(const uint8_t *record, uint8_t size)
+{
+    if (fieldSize + size <= sizeof(fieldRecording))
+    {
+        memcpy(fieldRecording + fieldSize, record, size);
+        fieldSize += size;
+    }
+}
+
+void testRecorder()
+{
+    SI470X rx, replayed;
+    SI470XRdsReplay replay;
+    si470x_rds_group group = {0xE0F1, 0x2401, 0x5532, 0x434C, 0x9C}, back;
+    uint8_t record[SI470X_RDS_RECORD_SIZE];
+    uint32_t total = 0, late = 0;
+    uint16_t delta;
+    FILE *file;
+
+    begin(rx, "RDS recorder and replay");
+    SI470X::encodeRdsRecord(&group, 1234, record);
+    CHECK(record[0] == 0x04 && record[1] == 0xD2 && record[2] == 0xE0 && record[10] == 0x9C); // Big endian, BLER last
+    CHECK(SI470X::decodeRdsRecord(record, &back) == 1234);
+    CHECK(back.blockA == group.blockA && back.blockB == group.blockB && back.blockC == group.blockC && back.blockD == group.blockD);
+    CHECK(back.bler == group.bler);
+
+    // Recorded from the device, then replayed into another receiver
+    fieldSize = 0;
+    rx.clearRdsBuffer();
+    rx.resetRdsFifoStats();
+    rx.setRdsRecorder(recordGroup);
+    run(rx, 3000);
+    rx.setRdsRecorder(NULL);
+    CHECK(fieldSize / SI470X_RDS_RECORD_SIZE == rx.getRdsFifoStats().received);
+    replay.setRecording(fieldRecording, fieldSize);
+    while (replay.next(&back, &delta))
+    {
+        if (total != 0 && (delta < 80 || delta > 100))
+            late++; // One group every 87.6 ms
+        total += delta;
+    }
+    CHECK(late == 0 && total <= 3000);
+    CHECK(replay.getGroupCount() == fieldSize / SI470X_RDS_RECORD_SIZE);
+
+    file = fopen("si470x_host_tests.rds", "wb");
+    CHECK(file != NULL && fwrite(fieldRecording, 1, fieldSize, file) == fieldSize);
+    if (file != NULL)
+        fclose(file);
+    CHECK(replay.load("si470x_host_tests.rds") && replay.getGroupCount() == fieldSize / SI470X_RDS_RECORD_SIZE);
+    remove("si470x_host_tests.rds");
+    replayed.clearRdsBuffer();
+    CHECK(replay.decode(replayed, true) == replay.getGroupCount());
+    CHECK(same(replayed.getRdsStationName(), rx.getRdsStationName()));
+    CHECK(same(replayed.getRdsProgramInformation(), rx.getRdsProgramInformation()));
+    CHECK(replayed.getRdsPi() == rx.getRdsPi());
+}
+
+void testPiConfirmation()
+{
+    SI470X rx;
+    si470x_rds_group other = {0x1234, 0x0400, 0xE0CD, 0x5A55, 0};
+
+    printf("PI confirmation\n");
+    rx.clearRdsBuffer();
+    rx.processRdsGroup(&groupsX[0]);
+    CHECK(rx.getRdsPi() == 0); // SI470X_RDS_PI_CONFIRM receptions needed
+    rx.processRdsGroup(&groupsX[1]);
+    CHECK(rx.getRdsPi() == 0xE0F1);
+    CHECK(rx.isSameStation(0xE0F1));
+    CHECK(!rx.isSameStation(0));
+
+    rx.processRdsGroup(&other); // A single corrupted block A is not a new station
+    CHECK(rx.getRdsPi() == 0xE0F1);
+    rx.processRdsGroup(&groupsX[2]);
+    rx.processRdsGroup(&other);
+    rx.processRdsGroup(&other);
+    CHECK(rx.getRdsPi() == 0x1234);
+    CHECK(!rx.isSameStation(0xE0F1));
+
+    rx.setRdsPiConfirm(1);
+    rx.processRdsGroup(&groupsX[0]);
+    CHECK(rx.getRdsPi() == 0xE0F1);
+}
+
+void testSameStation()
+{
+    SI470X rx;
+    uint16_t pi;
+
+    begin(rx, "same station after a tune");
+    run(rx, 500);
+    pi = rx.getRdsPi();
+    CHECK(pi == 0xE0F1);
+
+    rx.setFrequency(9200); // No station, no RDS
+    CHECK(rx.getRdsPi() == 0);
+    run(rx, 1000);
+    CHECK(!rx.isSameStation(pi));
+
+    rx.setFrequency(10250); // Another station
+    run(rx, 1000);
+    CHECK(rx.getRdsPi() == 0xC0DE);
+    CHECK(!rx.isSameStation(pi));
+
+    rx.setFrequency(9750); // Alternative frequency of the same station
+    CHECK(!rx.isSameStation(pi));
+    run(rx, 500);
+    CHECK(rx.isSameStation(pi));
+}
+
+void testCache()
+{
+    SI470X rx;
+
+    begin(rx, "RDS cache");
+    rx.clearRdsCache();
+    rx.clearRdsBuffer();
+    run(rx, 100);
+    CHECK(rx.getRdsStationName() == NULL); // Miss: the name needs 4 groups
+    run(rx, 1500);
+    CHECK(same(rx.getRdsStationName(), "PU2CLR  "));
+
+    rx.setFrequency(10250);
+    run(rx, 1500);
+    CHECK(same(rx.getRdsStationName(), "ZULU FM "));
+    CHECK(rx.getRdsPi() == 0xC0DE);
+
+    rx.setFrequency(10650);
+    run(rx, 150); // The first group (block A) finds X in the cache. The name takes more than 1 s.
+    CHECK(same(rx.getRdsStationName(), "PU2CLR  "));
+    CHECK(same(rx.getRdsProgramInformation(), "Hi PU2CLR"));
+
+    // Y sends only radio text: the name of X must not be shown on Y nor cached for Y (X -> Y -> Z -> Y)
+    rx.setFrequency(9800);
+    run(rx, 1500);
+    CHECK(rx.getRdsPi() == 0xD001);
+    CHECK(rx.getRdsStationName() == NULL);
+    CHECK(same(rx.getRdsProgramInformation(), "Only text"));
+    rx.setFrequency(10250);
+    run(rx, 1500);
+    CHECK(same(rx.getRdsStationName(), "ZULU FM "));
+    CHECK(rx.getRdsProgramInformation() == NULL); // Z sends no text
+    rx.setFrequency(9800);
+    run(rx, 150);
+    CHECK(same(rx.getRdsProgramInformation(), "Only text")); // Cache hit
+    run(rx, 1500);
+    CHECK(rx.getRdsStationName() == NULL);
+}
+
+void testAfFollow()
+{
+    SI470X rx;
+    si470x_bus_stats before, after;
+
+    begin(rx, "AF follow");
+    rx.setRdsAfFollow(true);
+    run(rx, 2000);
+    CHECK(rx.getRdsPi() == 0xE0F1 && rx.getRdsAfCount() == 3);
+    CHECK(rx.getFrequency() == 10650); // Good signal: it stays
+
+    // 106.5 MHz fades. 102.5 MHz (first AF) is another station; 97.5 MHz carries X.
+    stations[ST_10650].rssi = 12;
+    run(rx, 3000);
+    CHECK(rx.getFrequency() == 9750);
+    CHECK(sim.getRegister(REG03) == CH_9750);
+    CHECK(!rx.isRdsAfSearching());
+    CHECK((sim.getRegister(REG02) & 0x4000) != 0); // DMUTE: audio on again
+    CHECK(rx.getRdsPi() == 0xE0F1);
+    CHECK(same(rx.getRdsStationName(), "PU2CLR  "));
+
+    // No AF is better: back to the station, the failed AF is not tried again and the rounds get rarer
+    stations[ST_9750].rssi = 10;
+    stations[ST_10650].rssi = 8;
+    run(rx, 5000);
+    CHECK(rx.getFrequency() == 9750);
+    CHECK((sim.getRegister(REG02) & 0x4000) != 0);
+    before = rx.getBusStats();
+    run(rx, 10000);
+    after = rx.getBusStats();
+    CHECK(after.writeTransactions - before.writeTransactions <= 10); // 2 rounds (4 s and 8 s apart): 2 tunes (TUNE set and cleared) and unmute each
+    while (rx.isRdsAfSearching())
+        run(rx, 5);
+    CHECK(rx.getFrequency() == 9750);
+}
+
+void testAfAfterTune()
+{
+    SI470X rx;
+
+    begin(rx, "AF follow after a tune");
+    rx.setRdsAfFollow(true);
+    run(rx, 2000);
+    CHECK(rx.getRdsAfCount() == 3);
+
+    rx.setFrequency(9200); // The user tunes a frequency without RDS (weak signal). The AF list of 106.5 MHz must not bring it back.
+    CHECK(rx.getRdsAfCount() == 0);
+    run(rx, 10000);
+    CHECK(rx.getFrequency() == 9200);
+    CHECK(sim.getRegister(REG03) == CH_9200);
+    CHECK(!rx.isRdsAfSearching());
+
+    rx.seek(SI470X_SEEK_WRAP, SI470X_SEEK_UP); // 97.5 MHz: X again, with a weak signal. The AF list comes back with the station.
+    CHECK(rx.getFrequency() == 9750);
+    stations[ST_9750].rssi = 15;
+    run(rx, 5000);
+    CHECK(rx.getFrequency() == 10650);
+}
+
+int trafficStarted = 0, trafficFinished = 0;
+
+void countTrafficAnnouncement(bool active)
+{
+    if (active)
+        trafficStarted++;
+    else
+        trafficFinished++;
+}
+
+void setTrafficFlags(bool station, bool eon)
+{
+    for (uint8_t i = 0; i < sizeof(groupsT) / sizeof(si470x_rds_group); i++)
+        groupsT[i].blockB = station ? (groupsT[i].blockB | 0x0010) : (groupsT[i].blockB & ~0x0010);
+    groupsXEon[EON_TA_GROUP].blockB = eon ? (groupsXEon[EON_TA_GROUP].blockB | 0x0008) : (groupsXEon[EON_TA_GROUP].blockB & ~0x0008);
+}
+
+void testTrafficEon()
+{
+    SI470X rx;
+
+    begin(rx, "Traffic mode (EON)");
+    setTrafficFlags(true, true);
+    sim.setStations(trafficStations, sizeof(trafficStations) / sizeof(si470x_sim_station));
+    rx.setFrequency(10650);
+    rx.onTrafficAnnouncement(countTrafficAnnouncement);
+    rx.setRdsTrafficMode(true);
+    maxDecoderWrites = 0;
+
+    // X announces traffic on T: the decoder requests the switch and poll() tunes
+    for (unsigned long start = millis(); !rx.isRdsTrafficSwitched() && (millis() - start) < 3000;)
+        run(rx, 5);
+    CHECK(rx.isRdsTrafficSwitched());
+    CHECK(trafficStarted == 1);
+    run(rx, 1500);
+    CHECK(rx.getFrequency() == 10390);
+    CHECK(sim.getRegister(REG03) == CH_10390);
+    CHECK(rx.isRdsTrafficSwitched()); // T has its own TA flag: confirmed
+    CHECK(same(rx.getRdsStationName(), "TRAFFIC "));
+
+    // End of the announcement on T: back to X
+    setTrafficFlags(false, false);
+    run(rx, 1500);
+    CHECK(trafficFinished == 1);
+    CHECK(!rx.isRdsTrafficSwitched());
+    CHECK(rx.getFrequency() == 10650);
+    CHECK(sim.getRegister(REG03) == CH_10650);
+
+    // T does not confirm the announcement: back to X after SI470X_TRAFFIC_TIMEOUT
+    setTrafficFlags(false, true);
+    for (unsigned long start = millis(); !rx.isRdsTrafficSwitched() && (millis() - start) < 3000;)
+        run(rx, 5);
+    CHECK(rx.isRdsTrafficSwitched());
+    setTrafficFlags(false, false);
+    run(rx, SI470X_TRAFFIC_TIMEOUT + 500);
+    CHECK(!rx.isRdsTrafficSwitched());
+    CHECK(rx.getFrequency() == 10650);
+
+    CHECK(maxDecoderWrites <= 1); // Traffic volume. No tune from inside processRdsGroup().
+
+    // Traffic mode turned off on T: the announcement finishes and poll() tunes back. A new announcement switches again.
+    setTrafficFlags(true, true);
+    for (unsigned long start = millis(); !rx.isRdsTrafficSwitched() && (millis() - start) < 3000;)
+        run(rx, 5);
+    run(rx, 1500);
+    CHECK(rx.getFrequency() == 10390);
+    trafficFinished = 0;
+    rx.setRdsTrafficMode(false);
+    CHECK(trafficFinished == 1);
+    CHECK(!rx.isRdsTrafficSwitched());
+    CHECK(rx.getFrequency() == 10390); // The setter does not tune
+    setTrafficFlags(false, true);
+    run(rx, 500);
+    CHECK(rx.getFrequency() == 10650);
+    rx.setRdsTrafficMode(true);
+    for (unsigned long start = millis(); !rx.isRdsTrafficSwitched() && (millis() - start) < 3000;)
+        run(rx, 5);
+    CHECK(rx.isRdsTrafficSwitched());
+    setTrafficFlags(false, false);
+    run(rx, 1500);
+    CHECK(rx.getFrequency() == 10650);
+
+    // Seek started after the decoder requested the switch and before poll(): the switch is cancelled
+    setTrafficFlags(false, true);
+    for (unsigned long start = millis(); !rx.isRdsTrafficSwitched() && (millis() - start) < 3000;)
+        run(rx, 5);
+    CHECK(rx.isRdsTrafficSwitched() && rx.getFrequency() == 10650);
+    rx.seekAsync(SI470X_SEEK_STOP, SI470X_SEEK_UP); // No station up to the band limit (108 MHz)
+    while (!rx.poll())
+        delay(1);
+    CHECK(rx.getFrequency() == 10800);
+    run(rx, 500);
+    CHECK(rx.getFrequency() == 10800);
+    CHECK(!rx.isRdsTrafficSwitched());
+
+    setTrafficFlags(false, false);
+    rx.setRdsTrafficMode(false);
+    rx.onTrafficAnnouncement(NULL);
+}
+
+void testPollIsShort()
+{
+    printf("poll() cost\n");
+    CHECK(maxPollTransactions <= 3); // Status read, register write (+ status) at the end of a tune
+    CHECK(maxPollTime < 5000);       // us. About 1.2 ms per 12 bytes at 100 kHz.
+}
+
+int main()
+{
+    si470xHostUseVirtualClock(true); // delay() does not sleep. The simulated bus advances the clock.
+
+    testDecoder();
+    testStationName();
+    testClockTime();
+    testRadioText();
+    testRtPlusGroup();
+    testRdsHandlers();
+    testLayoutCheck();
+    testDirtyRegisters();
+#if defined(__linux__)
+    testLinuxBus();
+#endif
+    testPartialReads();
+    testRdsMode();
+    testAsyncTune();
+    testSeekAsync();
+    testStcInterrupt();
+    testRdsFifo();
+    testSeekCancel();
+    testSeekAfterTune();
+    testRdsStats();
+    testRecorder();
+    testPiConfirmation();
+    testSameStation();
+    testCache();
+    testAfFollow();
+    testAfAfterTune();
+    testTrafficEon();
+    testPollIsShort();
+
+    printf("\n%d checks, %d failed (worst poll: %u transactions, %lu us)\n", checks, failures, (unsigned)maxPollTransactions, maxPollTime);
+    return failures == 0 ? 0 : 1;
+}
@@ -10,11 +10,125 @@
 
 #include <SI470X.h>
 
+#if defined(ARDUINO)
+SI470XWireBus si470xDefaultBus;
+
+/**
+ * @ingroup GA03
+ * @brief Writes a sequence of bytes to the device using the Wire library
+ * @see SI470XBus::write
+ */
+uint8_t SI470XWireBus::write(uint8_t address, const uint8_t *data, uint8_t size)
+{
+    wire->beginTransmission(address);
+    for (uint8_t i = 0; i < size; i++)
+        wire->write(data[i]);
+    return wire->endTransmission();
+}
+
+/**
+ * @ingroup GA03
+ * @brief Reads a sequence of bytes from the device using the Wire library
+ * @details The way to wait for the bytes depends on the platform (see SI470X_READ_WAIT).
+ * @details Most cores only return from requestFrom after receiving all bytes, so there is nothing to wait for.
+ * @details On ATtiny cores, waiting on Wire.available() did not work, so a fixed delay is used.
+ * @see SI470XBus::read
+ */
+uint8_t SI470XWireBus::read(uint8_t address, uint8_t *data, uint8_t size)
+{
+    uint8_t i;
+    wire->requestFrom(address, size);
+#if SI470X_READ_WAIT == SI470X_READ_WAIT_FIXED
+    delayMicroseconds(SI470X_READ_DELAY);
+#else
+#if SI470X_READ_WAIT == SI470X_READ_WAIT_POLL
+    unsigned long start = micros();
+    while (wire->available() < size && (micros() - start) < SI470X_READ_TIMEOUT)
+        ;
+#endif
+    if (wire->available() < size)
+        size = wire->available();
+#endif
+    for (i = 0; i < size; i++)
+        data[i] = wire->read();
+    return i;
+}
+#endif
+
+SI470X *SI470X::interruptReceiver = NULL;
+
 /** 
  * @defgroup GA03 Basic Functions
  * @section GA03 Basic
  */
 
+/**
+ * @ingroup GA03
+ * @brief Reads bytes from the device through the current transport
+ * @details The device always starts sending the upper byte of the register 0x0A.
+ * @param data buffer
+ * @param size number of bytes
+ * @return number of bytes read
+ */
+uint8_t SI470X::readBytes(uint8_t *data, uint8_t size)
+{
+#if SI470X_BUS_STATS
+    unsigned long start = micros();
+    uint8_t n = this->bus->read(this->deviceAddress, data, size);
+    this->busStats.readMicros += micros() - start;
+    this->busStats.readTransactions++;
+    this->busStats.bytesRead += n;
+    return n;
+#else
+    return this->bus->read(this->deviceAddress, data, size);
+#endif
+}
+
+/**
+ * @ingroup GA03
+ * @brief Writes bytes to the device through the current transport
+ * @details The device always stores the first byte in the upper byte of the register 0x02.
+ * @param data bytes to be sent
+ * @param size number of bytes
+ * @return 0 if success
+ */
+uint8_t SI470X::writeBytes(const uint8_t *data, uint8_t size)
+{
+    uint8_t error = this->bus->write(this->deviceAddress, data, size);
+#if SI470X_BUS_STATS
+    if (error == 0)
+    {
+        this->busStats.writeTransactions++;
+        this->busStats.bytesWritten += size;
+    }
+#endif
+    return error;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Writes bytes to the device and reads the following bytes through the current transport
+ * @details Transports with combined transactions (for example, SI470XLinuxBus) do it in a single round trip.
+ * @param wdata bytes to be sent
+ * @param wsize number of bytes to be sent
+ * @param rdata buffer that will receive the bytes (starting at the upper byte of the register 0x0A)
+ * @param rsize number of bytes to be read
+ * @return number of bytes read (0 if the write failed)
+ */
+uint8_t SI470X::writeReadBytes(const uint8_t *wdata, uint8_t wsize, uint8_t *rdata, uint8_t rsize)
+{
+    uint8_t n = this->bus->writeRead(this->deviceAddress, wdata, wsize, rdata, rsize);
+#if SI470X_BUS_STATS
+    if (n == 0)
+        return 0;
+    this->busStats.writeTransactions++;
+    this->busStats.bytesWritten += wsize;
+    this->busStats.readTransactions++;
+    this->busStats.bytesRead += n;
+#endif
+    return n;
+}
+
 /**
  * @ingroup GA03
  * @brief Gets all current register content of the device
@@ -24,28 +138,60 @@
  * @see shadowRegisters;  
  */
 void SI470X::getAllRegisters()
+{
+    getRegisters(16);
+}
+
+/**
+ * @ingroup GA03
+ * @brief Gets the content of the first "count" registers sent by the device
+ * @details The device always starts sending the register 0x0A, followed by 0x0B to 0x0F and then 0x00 to 0x09.
+ * @details So, read only what you need. For example:
+ *
+ * | count | Registers                 | Bytes |
+ * | ----- | ------------------------- | ----- |
+ * |   1   | 0x0A (status, RSSI)       |   2   |
+ * |   2   | 0x0A and 0x0B (READCHAN)  |   4   |
+ * |   6   | 0x0A to 0x0F (RDS)        |  12   |
+ * |   8   | 0x0A to 0x0F, 0x00, 0x01  |  16   |
+ * |  16   | All registers             |  32   |
+ *
+ * @see getAllRegisters, getStatus, getRdsStatus
+ * @param count number of registers (1 to 16)
+ */
+void SI470X::getRegisters(uint8_t count)
 {
     word16_to_bytes aux;
-    int i;
+    uint8_t data[32];
+    uint8_t *p = data;
+    uint8_t reg = REG0A;
+
+    if (count == 0 || count > 16)
+        count = 16;
 
-    Wire.requestFrom(this->deviceAddress, 32);
-    delayMicroseconds(300);
-    // while (Wire.available() < 32); // It did not work on Attiny Core
+    count = readBytes(data, count * 2) / 2; // Only the registers actually received
 
-    // The registers from 0x0A to 0x0F come first
-    for (i = 0x0A; i <= 0x0F; i++)
+    for (uint8_t i = 0; i < count; i++)
     {
-        aux.refined.highByte = Wire.read();
-        aux.refined.lowByte = Wire.read();
-        shadowRegisters[i] = aux.raw;
+        aux.refined.highByte = *p++;
+        aux.refined.lowByte = *p++;
+        shadowRegisters[reg] = aux.raw;
+        reg = (reg + 1) & 0x0F;
     }
 
-    for (i = 0x00; i <= 0x09; i++)
+    // Now the device and the shadow registers have the same content (0x02 is the 9th register sent)
+    if (count > 8)
+        memcpy(deviceRegisters, &shadowRegisters[REG02], ((count > 14) ? 6 : count - 8) * sizeof(uint16_t));
+
+#if SI470X_RDS_STATS
+    // RDS synchronization losses: every status read is checked (no extra read). Tuning always loses it.
+    if (count > 0)
     {
-        aux.refined.highByte = Wire.read();
-        aux.refined.lowByte = Wire.read();
-        shadowRegisters[i] = aux.raw;
+        if (this->rdsSynced && !reg0a->refined.RDSS && this->tuneState == SI470X_TUNE_IDLE)
+            this->rdsStats.syncLosses++;
+        this->rdsSynced = reg0a->refined.RDSS;
     }
+#endif
 }
 
 /**
@@ -55,21 +201,104 @@ void SI470X::getAllRegisters()
  * @details An internal address counter automatically increments to allow continuous data byte writes, starting with the upper byte of register 02h, followed by the lower byte of register 02h, and onward until the lower byte of the last register is reached. The internal address counter then automatically wraps around to the upper byte of register 00h and proceeds from there until continuous writes end.
  *  @details The registers from 0x2 to 0x07 are used to setup the device. This method writes the array  shadowRegisters, elements 8 to 14 (corresponding the registers 0x2 to 0x7 respectively)  into the device. See Device registers map  in SI470X.h file.
  * @details To implement this, a register maping was created to deal with each register structure. For each type of register, there is a reference to the array element. 
+ * @details Only the registers that differ from the device content are considered (see getDirtyRegisters). Since the write always starts at 0x02, the transmission goes from 0x02 up to the highest changed register. If nothing has changed, the bus is not used at all.
  *  
  * @see BROADCAST FM RADIO TUNER FOR PORTABLE APPLICATIONS; pages 18 and 19.
- * @see shadowRegisters; 
+ * @see shadowRegisters, getDirtyRegisters, getBusStats
+ * @param limit  last register to be considered (default 0x07)
  */
 void SI470X::setAllRegisters(uint8_t limit)
+{
+    flushRegisters(limit, false);
+}
+
+/**
+ * @ingroup GA03
+ * @brief   Sets values to the device registers from 0x02 to limit and gets the status register (0x0A)
+ * @details Same as setAllRegisters followed by getStatus. Transports with combined transactions (for example, SI470XLinuxBus) do it in a single round trip.
+ * @details If no register has changed, only the status is read.
+ * @see setAllRegisters, getStatus
+ * @param limit  last register to be considered (default 0x07)
+ */
+void SI470X::setAllRegistersAndGetStatus(uint8_t limit)
+{
+    flushRegisters(limit, true);
+}
+
+/**
+ * @ingroup GA03
+ * @brief   Sends the changed registers (from 0x02 up to the highest changed register) to the device
+ * @see setAllRegisters, setAllRegistersAndGetStatus
+ * @param limit       last register to be considered
+ * @param readStatus  if true, reads the register 0x0A right after the write
+ */
+void SI470X::flushRegisters(uint8_t limit, bool readStatus)
 {
     word16_to_bytes aux;
-    Wire.beginTransmission(this->deviceAddress);
-    for (int i = 0x02; i <= limit; i++)
+    uint8_t data[28];
+    uint8_t status[2];
+    uint8_t *p = data;
+    uint8_t last = 0x01;
+
+    if (limit < REG02 || limit > REG0F)
+        return;
+
+    // Finds the highest register with content different from the device
+    for (uint8_t i = 0x02; i <= limit; i++)
+    {
+        if (i > REG07 || shadowRegisters[i] != deviceRegisters[i - REG02])
+            last = i;
+    }
+
+#if SI470X_BUS_STATS
+    this->busStats.bytesSaved += (limit - last) * 2;
+#endif
+    if (last < REG02)
+    {
+        // Nothing to be sent
+        if (readStatus)
+            getStatus();
+        return;
+    }
+
+    for (int i = 0x02; i <= last; i++)
     {
         aux.raw = shadowRegisters[i];
-        Wire.write(aux.refined.highByte);
-        Wire.write(aux.refined.lowByte);
+        *p++ = aux.refined.highByte;
+        *p++ = aux.refined.lowByte;
+    }
+
+    if (readStatus)
+    {
+        if (writeReadBytes(data, p - data, status, 2) == 0)
+            return; // keeps the registers dirty if the device did not receive them
+        aux.refined.highByte = status[0];
+        aux.refined.lowByte = status[1];
+        shadowRegisters[REG0A] = aux.raw;
+    }
+    else if (writeBytes(data, p - data) != 0)
+        return; // keeps the registers dirty if the device did not receive them
+
+    for (int i = 0x02; i <= last && i <= REG07; i++)
+        deviceRegisters[i - REG02] = shadowRegisters[i];
+}
+
+/**
+ * @ingroup GA03
+ * @brief   Gets the registers (0x02 to 0x07) that need to be sent to the device
+ * @details A register is dirty when its shadow content differs from the latest content written to or read from the device.
+ * @see setAllRegisters
+ * @return uint16_t bit mask. Bit n set means register n is dirty.
+ */
+uint16_t SI470X::getDirtyRegisters()
+{
+    uint16_t mask = 0;
+    for (uint8_t i = REG02; i <= REG07; i++)
+    {
+        if (shadowRegisters[i] != deviceRegisters[i - REG02])
+            mask |= (1 << i);
     }
-    Wire.endTransmission();
+    return mask;
 }
 
 /**
@@ -80,14 +309,7 @@ void SI470X::setAllRegisters(uint8_t limit)
  */
 void SI470X::getStatus()
 {
-    word16_to_bytes aux;
-    Wire.requestFrom(this->deviceAddress, 2);
-    delayMicroseconds(300);
-    // while (Wire.available() < 2) ; // It did not work on Attiny Core
-
-    aux.refined.highByte = Wire.read();
-    aux.refined.lowByte = Wire.read();
-    shadowRegisters[0x0A] = aux.raw;
+    getRegisters(1);
 }
 
 /**
@@ -95,22 +317,252 @@ void SI470X::getStatus()
  * @brief   Wait STC (Seek/Tune Complete) status becomes 0
  * @details Should be used before processing Tune or Seek.
  * @details The STC bit being cleared indicates that the TUNE or SEEK bits may be set again to start another tune or seek operation. Do not set the TUNE or SEEK bits until the Si470x clears the STC bit. 
+ * @details It runs the tune state machine (see poll) until the current operation finishes.
  */
 void SI470X::waitAndFinishTune()
 {
-    do
-    {
-        getStatus();
-    } while (reg0a->refined.STC == 0);
+    while (!poll())
+        delay(1);
+}
 
-    getAllRegisters();
-    reg02->refined.SEEK = 0;
-    reg03->refined.TUNE = 0;
+/**
+ * @ingroup GA03
+ * @brief   Starts tuning a channel (sets TUNE) without waiting
+ * @param channel  channel
+ * @param retune  SI470X_RETUNE_USER (new station), SI470X_RETUNE_TRAFFIC (EON traffic station) or SI470X_RETUNE_AF (same station on an Alternative Frequency)
+ */
+void SI470X::startTune(uint16_t channel, uint8_t retune)
+{
+    reg03->refined.CHAN = channel;
+    reg03->refined.TUNE = 1;
+    this->currentFrequency = channelToFrequency(channel);
+    this->stcInterrupt = false;
+    if (retune == SI470X_RETUNE_AF)
+        clearRdsFifo(); // Same station: only the groups of the previous frequency are discarded
+    else
+        changeRdsStation(retune);
     setAllRegisters();
-    do
+    this->tuneState = SI470X_TUNE_WAIT_STC;
+    this->tuneStart = this->lastPoll = millis();
+}
+
+/**
+ * @ingroup GA03
+ * @brief   Starts a seek (sets SEEK) without waiting
+ * @param seek_mode  Seek Mode; 0 = Wrap at the upper or lower band limit and continue seeking; 1 = Stop seeking at the upper or lower band limit.
+ * @param direction  Seek Direction; 0 = Seek down; 1 = Seek up.
+ */
+void SI470X::startSeek(uint8_t seek_mode, uint8_t direction)
+{
+    reg03->refined.TUNE = 1;
+    reg02->refined.SEEK = 1; // Enable seek
+    reg02->refined.SKMODE = seek_mode;
+    reg02->refined.SEEKUP = direction;
+    this->stcInterrupt = false;
+    changeRdsStation();
+    setAllRegisters();
+    this->tuneState = SI470X_TUNE_WAIT_STC;
+    this->tuneStart = this->lastPoll = millis();
+#if SI470X_SEEK_STATS
+    this->seekStats.count++;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief   Prepares the RDS decoder for a new station (tune or seek)
+ * @details The groups in the FIFO, the partial name and text, the PI code and the AF list belong to the previous station. The published information
+ * @details is kept until clearRdsBuffer is called, new information arrives (see the RDS cache) or another PI code is confirmed (see processRdsPi).
+ * @param retune  SI470X_RETUNE_USER cancels the EON traffic switch; SI470X_RETUNE_TRAFFIC keeps it
+ */
+void SI470X::changeRdsStation(uint8_t retune)
+{
+    clearRdsFifo();
+    storeRdsCache();
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PS)
+    this->rdsPsReady = 0;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    this->rdsRtSegments = 0;
+    this->rdsRtFlagAB = 0xFF;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PTYN)
+    this->rdsPtynReady = 0;
+#endif
+    this->rdsPi = this->rdsPiCandidate = 0; // The new station must confirm its own PI code (see isSameStation)
+    this->rdsPiCount = 0;
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    this->rdsAfCount = 0; // The AF list comes back with the station (or from the RDS cache)
+    this->rdsAfPi = 0;
+    this->rdsAfMethodB = false;
+    this->afFailed = 0;
+    this->afCheckInterval = SI470X_AF_CHECK_INTERVAL;
+    this->afCheckTime = millis();
+    if (this->afState != SI470X_AF_IDLE)
+    {
+        reg02->refined.DMUTE = this->afDmute; // Written with the tune. The AF round is abandoned.
+        this->afState = SI470X_AF_IDLE;
+    }
+#endif
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    this->rdsRtPlusCount = 0;
+    this->rdsRtPlusGroup = this->rdsRtPlusToggle = 0xFF;
+#endif
+#if SI470X_RDS_TRAFFIC
+    if (retune == SI470X_RETUNE_USER)
+        this->trafficReturnFrequency = 0;
+#else
+    (void)retune;
+#endif
+#if SI470X_RDS_STATS
+    this->rdsSynced = false;
+#endif
+    unbindRdsOda();
+}
+
+/**
+ * @ingroup GA03
+ * @brief   GPIO2 interrupt handler (STC and RDS ready pulses)
+ * @details It does not use the I2C bus (the Wire library cannot be used inside an interrupt on most platforms).
+ * @details It just tells poll() and rdsCapture() that the status register must be read.
+ */
+void SI470X_ISR_ATTR SI470X::gpio2InterruptHandler()
+{
+    SI470X *rx = interruptReceiver;
+
+    if (rx == NULL)
+        return;
+    rx->stcInterrupt = true;
+    if (rx->rdsInterruptPin >= 0 && rx->rdsPulses < 255)
+        rx->rdsPulses++;
+}
+
+/**
+ * @ingroup GA03
+ * @brief   Moves the tune state machine one step forward
+ * @details TUNE/SEEK set -> STC = 1 -> clear TUNE/SEEK -> STC = 0 -> idle (or starts the pending channel or seek).
+ * @details It reads the status register (0x0A) every call. See poll() for the rate limited version.
+ * @return true if there is no tune or seek in progress
+ */
+bool SI470X::tuneStep()
+{
+    switch (this->tuneState)
     {
+    case SI470X_TUNE_WAIT_STC:
+        if (reg02->refined.SEEK)
+        {
+            // Seeking: READCHAN shows the progress
+            getRegisters(2);
+            if (reg0a->refined.STC)
+            {
+                seekFinished(reg0a->refined.SF_BL ? SI470X_SEEK_EVENT_FAILED : SI470X_SEEK_EVENT_FOUND);
+            }
+            else if (channelToFrequency(reg0b->refined.READCHAN) != this->currentFrequency)
+            {
+                this->currentFrequency = channelToFrequency(reg0b->refined.READCHAN);
+                if (this->seekEventHandler != NULL)
+                    this->seekEventHandler(SI470X_SEEK_EVENT_PROGRESS, this->currentFrequency);
+            }
+        }
+        else
+            getStatus();
+        if (reg0a->refined.STC == 0)
+            return false;
+        reg02->refined.SEEK = 0;
+        reg03->refined.TUNE = 0;
+        setAllRegistersAndGetStatus(); // The device clears STC after TUNE and SEEK are cleared
+        this->tuneState = SI470X_TUNE_WAIT_CLEAR;
+        if (reg0a->refined.STC != 0)
+            return false;
+        break;
+    case SI470X_TUNE_WAIT_CLEAR:
         getStatus();
-    } while (reg0a->refined.STC != 0);
+        if (reg0a->refined.STC != 0)
+            return false;
+        break;
+    default:
+        return true;
+    }
+
+    this->tuneState = SI470X_TUNE_IDLE;
+    this->rdsPulses = 0; // The STC pulse (shared GPIO2) is not an RDS group
+    if (this->pendingChannel != SI470X_NO_CHANNEL)
+    {
+        startTune(this->pendingChannel, this->pendingRetune);
+        this->pendingChannel = SI470X_NO_CHANNEL;
+        return false;
+    }
+    if (this->pendingSeek != SI470X_NO_SEEK)
+    {
+        startSeek(this->pendingSeek >> 1, this->pendingSeek & 1);
+        this->pendingSeek = SI470X_NO_SEEK;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @ingroup GA03
+ * @brief   Moves the tune state machine forward (non-blocking)
+ * @details Call it from your loop after setFrequencyAsync or setChannelAsync. While it returns false, your sketch can do other things (display, encoder, RDS).
+ * @details To avoid using the I2C bus all the time, the status is not read during the typical tune time (SI470X_TUNE_TIME) and not more than once every SI470X_POLL_INTERVAL ms.
+ * @details If the GPIO2 is connected to an interrupt pin (seekInterruptPin, see setup), the status is read only after the STC pulse.
+ * @details In this case, poll() reads it every SI470X_INTERRUPT_POLL_INTERVAL ms while seeking (progress) or if the pulse is missed.
+ * @details When idle, it starts the tune requested by the RDS decoder (EON traffic switch, see setRdsTrafficMode), stores the RDS group signaled
+ * @details by the RDS interrupt, if any (see rdsCapture), or runs one step of the AF follow mode (see setRdsAfFollow). It also leaves an EON
+ * @details traffic station that does not confirm the announcement.
+ * @code
+ * rx.setFrequencyAsync(10390);
+ * .
+ * .
+ * void loop() {
+ *   if (rx.poll()) {
+ *      // Tuned. Nothing in progress
+ *   }
+ *   // Do other things
+ * }
+ * @endcode
+ * @see setFrequencyAsync, setChannelAsync, isTuneComplete
+ * @return true if there is no tune or seek in progress
+ */
+bool SI470X::poll()
+{
+    unsigned long now = millis();
+
+    if (this->tuneState == SI470X_TUNE_IDLE)
+    {
+        if (this->pendingChannel != SI470X_NO_CHANNEL)
+        {
+            startTune(this->pendingChannel, this->pendingRetune); // Requested by the RDS decoder
+            this->pendingChannel = SI470X_NO_CHANNEL;
+            return false;
+        }
+        if (this->rdsPulses != 0 && !isRdsAfSearching())
+            rdsCapture();
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+        else if (this->afFollow || isRdsAfSearching())
+            checkRdsAf();
+#endif
+#if SI470X_RDS_TRAFFIC
+        if (this->trafficReturnFrequency != 0 && !this->trafficConfirmed && (now - this->trafficSwitchTime) >= SI470X_TRAFFIC_TIMEOUT)
+            updateTrafficAnnouncement(false); // The EON traffic station did not confirm the announcement
+#endif
+        return this->tuneState == SI470X_TUNE_IDLE;
+    }
+    if (this->tuneState == SI470X_TUNE_WAIT_STC && isStcInterruptEnabled())
+    {
+        if (!this->stcInterrupt && (now - this->lastPoll) < SI470X_INTERRUPT_POLL_INTERVAL)
+            return false;
+        this->stcInterrupt = false;
+        this->lastPoll = now;
+        return tuneStep();
+    }
+    if (this->tuneState == SI470X_TUNE_WAIT_STC && (now - this->tuneStart) < SI470X_TUNE_TIME)
+        return false;
+    if ((now - this->lastPoll) < SI470X_POLL_INTERVAL)
+        return false;
+    this->lastPoll = now;
+    return tuneStep();
 }
 
 /**
@@ -139,7 +591,7 @@ void SI470X::powerUp()
     setAllRegisters();
     delay(this->maxDelayAftarCrystalOn); // You can set this value. See inline function setDelayAfterCrystalOn
 
-    getAllRegisters();
+    // The registers 0x02 to 0x07 are changed only by the host. So, there is no need to read them again.
 
     reg02->refined.DMUTE = 1; // Mutes the device;
     reg02->refined.MONO = 0;
@@ -152,14 +604,14 @@ void SI470X::powerUp()
     reg02->refined.ENABLE = 1; // Power up
     reg02->refined.DISABLE = 0;
 
-    reg04->refined.RDSIEN = 0;
-    reg04->refined.STCIEN = 0;
+    reg04->refined.RDSIEN = isRdsInterruptEnabled(); // 5 ms low pulse on GPIO2 when RDSR is set
+    reg04->refined.STCIEN = isStcInterruptEnabled(); // 5 ms low pulse on GPIO2 when STC is set
     reg04->refined.RDS = 0;
     reg04->refined.DE = 0;
     reg04->refined.AGCD = 1;
     reg04->refined.BLNDADJ = 1;
-    // TODO - link the GPIO with interrupt pins
-    reg04->refined.GPIO1 = reg04->refined.GPIO2 = reg04->refined.GPIO3 = 0;
+    reg04->refined.GPIO1 = reg04->refined.GPIO3 = 0;
+    reg04->refined.GPIO2 = isStcInterruptEnabled() || isRdsInterruptEnabled(); // 01 = STC/RDS interrupt; 00 = High impedance
 
     reg05->refined.SEEKTH = 0; // RSSI Seek Threshold;
     this->currentFMBand = reg05->refined.BAND = 0;
@@ -175,7 +627,7 @@ void SI470X::powerUp()
 
     setAllRegisters();
     delay(60);
-    getAllRegisters(); // Gets All registers (current status after powerup)
+    getRegisters(8); // Gets the status (0x0A to 0x0F) and the device ID registers (0x00 and 0x01) after powerup
     delay(60);
 }
 
@@ -185,7 +637,6 @@ void SI470X::powerUp()
  */
 void SI470X::powerDown()
 {
-    getAllRegisters();
     reg07->refined.AHIZEN = 1;
     // reg07->refined.RESERVED = 0x0100;
     reg04->refined.GPIO1 = reg04->refined.GPIO2 = reg04->refined.GPIO3 = 0;
@@ -202,12 +653,16 @@ void SI470X::powerDown()
  * @details You have to inform at least two parameters: RESET pin and I2C SDA pin of your MCU
  * @param resetPin         // Arduino pin used to reset control. 
  * @param sdaPin           // I2C data bus pin (SDA). For some reason the SI4703 does not start with this pin HIGH      
- * @param rdsInterruptPin  // optional. Sets the Interrupt Arduino pin used to RDS function control.
- * @param seekInterruptPin // optional. Sets the Arduino pin used to Seek function control. 
+ * @param rdsInterruptPin  // optional. Arduino interrupt pin connected to the GPIO2. When set, new RDS groups are signaled by the RDS interrupt (see rdsCapture).
+ * @param seekInterruptPin // optional. Arduino interrupt pin connected to the GPIO2 (it can be the same pin used for RDS). When set, tune and seek completion is signaled by the STC interrupt (see poll). 
  * @param oscillator_type  // optional. Sets the Oscillator type used Crystal (default) or Ref. Clock. 
+ * @param layout           // do not pass it. sizeof(SI470X) seen by the sketch: if it is not the size seen by the library, a configuration
+ *                         // macro was defined in the sketch instead of as a build flag (see SI470X.h). Nothing is done then.
  */
-void SI470X::setup(int resetPin, int sdaPin, int rdsInterruptPin, int seekInterruptPin, uint8_t oscillator_type)
+void SI470X::setup(int resetPin, int sdaPin, int rdsInterruptPin, int seekInterruptPin, uint8_t oscillator_type, size_t layout)
 {
+    if (layout != sizeof(SI470X))
+        return; // The sketch and the library see different classes: any access could corrupt the memory
 
     if (sdaPin >= 0)
     {
@@ -222,9 +677,26 @@ void SI470X::setup(int resetPin, int sdaPin, int rdsInterruptPin, int seekInterr
         this->seekInterruptPin = seekInterruptPin;
 
     this->oscillatorType = oscillator_type;
+    clearRdsCache();
+    clearRdsBuffer();
+    resetRdsStats();
+
+    // Both pins are connected to the GPIO2 (usually the same Arduino pin)
+    if (this->seekInterruptPin >= 0)
+    {
+        pinMode(this->seekInterruptPin, INPUT_PULLUP);
+        interruptReceiver = this;
+        attachInterrupt(digitalPinToInterrupt(this->seekInterruptPin), gpio2InterruptHandler, FALLING);
+    }
+    if (this->rdsInterruptPin >= 0 && this->rdsInterruptPin != this->seekInterruptPin)
+    {
+        pinMode(this->rdsInterruptPin, INPUT_PULLUP);
+        interruptReceiver = this;
+        attachInterrupt(digitalPinToInterrupt(this->rdsInterruptPin), gpio2InterruptHandler, FALLING);
+    }
 
     reset();
-    Wire.begin();
+    this->bus->begin();
     delay(1);
     powerUp();
 }
@@ -236,10 +708,11 @@ void SI470X::setup(int resetPin, int sdaPin, int rdsInterruptPin, int seekInterr
  * @param resetPin         // Arduino pin used to reset control.     
  * @param rdsInterruptPin  // optional. Sets the Arduino pin used to RDS function control.
  * @param seekInterruptPin // optional. Sets the Arduino pin used to Seek function control. 
+ * @param layout           // do not pass it (see the other setup)
  */
-void SI470X::setup(int resetPin, int sdaPin, uint8_t oscillator_type)
+void SI470X::setup(int resetPin, int sdaPin, uint8_t oscillator_type, size_t layout)
 {
-    setup(resetPin, sdaPin, -1, -1, oscillator_type);
+    setup(resetPin, sdaPin, -1, -1, oscillator_type, layout);
 }
 
 
@@ -251,13 +724,33 @@ void SI470X::setup(int resetPin, int sdaPin, uint8_t oscillator_type)
  */
 void SI470X::setChannel(uint16_t channel)
 {
-    reg03->refined.CHAN = channel;
-    reg03->refined.TUNE = 1;
-    setAllRegisters();
-    delayMicroseconds(60000);
+    setChannelAsync(channel);
     waitAndFinishTune();
 }
 
+/**
+ * @ingroup GA03
+ * @brief Starts tuning a channel and returns immediately
+ * @details Call poll() until it returns true (or isTuneComplete()) to finish the operation.
+ * @details If a tune or seek is in progress, the new channel is tuned as soon as it finishes. A seek in progress is aborted.
+ * @see poll, isTuneComplete, setFrequencyAsync
+ * @param channel 
+ */
+void SI470X::setChannelAsync(uint16_t channel)
+{
+    this->pendingSeek = SI470X_NO_SEEK; // The latest request wins
+    if (this->tuneState == SI470X_TUNE_IDLE)
+    {
+        this->pendingChannel = SI470X_NO_CHANNEL; // The EON traffic switch requested by the RDS decoder, if any, is cancelled
+        startTune(channel);
+        return;
+    }
+
+    this->pendingChannel = channel;
+    this->pendingRetune = SI470X_RETUNE_USER;
+    cancelSeek();
+}
+
 /**
  * @ingroup GA03
  * @brief Sets the FM frequency 
@@ -266,10 +759,26 @@ void SI470X::setChannel(uint16_t channel)
  */
 void SI470X::setFrequency(uint16_t frequency)
 {
-    uint16_t channel;
-    channel = (frequency - this->startBand[this->currentFMBand]) / this->fmSpace[this->currentFMSpace];
-    setChannel(channel);
-    this->currentFrequency = frequency;
+    setFrequencyAsync(frequency);
+    waitAndFinishTune();
+}
+
+/**
+ * @ingroup GA03
+ * @brief Starts tuning a FM frequency and returns immediately
+ * @details Same as setFrequency, but it does not wait for the tune to complete. Call poll() to finish the operation.
+ * @code
+ * rx.setFrequencyAsync(10650);
+ * while (!rx.poll()) {
+ *   // update display, read encoder, ...
+ * }
+ * @endcode
+ * @see poll, isTuneComplete, setChannelAsync
+ * @param frequency  7600 to 1080 (means 76Mhz to 108Mhz)
+ */
+void SI470X::setFrequencyAsync(uint16_t frequency)
+{
+    setChannelAsync(frequencyToChannel(frequency));
 }
 
 /**
@@ -320,7 +829,7 @@ uint16_t SI470X::getFrequency()
  */
 uint16_t SI470X::getRealChannel()
 {
-    getAllRegisters();
+    getRegisters(2); // 0x0A and 0x0B
     return reg0b->refined.READCHAN;
 }
 
@@ -333,7 +842,7 @@ uint16_t SI470X::getRealChannel()
  */
 uint16_t SI470X::getRealFrequency()
 {
-    return getRealChannel() * this->fmSpace[this->currentFMSpace] + this->startBand[this->currentFMBand];
+    return channelToFrequency(getRealChannel());
 }
 
 /**
@@ -350,14 +859,8 @@ uint16_t SI470X::getRealFrequency()
  */
 void SI470X::seek(uint8_t seek_mode, uint8_t direction)
 {
-    getAllRegisters();
-    reg03->refined.TUNE = 1;
-    reg02->refined.SEEK = 1; // Enable seek
-    reg02->refined.SKMODE = seek_mode;
-    reg02->refined.SEEKUP = direction;
-    setAllRegisters();
+    seekAsync(seek_mode, direction);
     waitAndFinishTune();
-    setFrequency(getRealFrequency());
 }
 
 /**
@@ -395,24 +898,113 @@ void SI470X::seek(uint8_t seek_mode, uint8_t direction)
  */
 void SI470X::seek(uint8_t seek_mode, uint8_t direction, void (*showFunc)())
 {
-    getAllRegisters();
+    uint16_t lastFrequency = this->currentFrequency;
+
+    seekAsync(seek_mode, direction);
     do
     {
-        reg03->refined.TUNE = 1;
-        reg02->refined.SEEK = 1; // Enable seek
-        reg02->refined.SKMODE = seek_mode;
-        reg02->refined.SEEKUP = direction;
-        setAllRegisters();
-        delay(60);
-        if (showFunc != NULL)
+        delay(1);
+        if (showFunc != NULL && this->currentFrequency != lastFrequency)
         {
+            lastFrequency = this->currentFrequency; // Shows only when the seek moves to a new channel
             showFunc();
         }
-        getStatus();
-        this->currentFrequency = getRealFrequency(); // gets the current seek frequency
-    } while (reg0a->refined.STC == 0);
-    waitAndFinishTune();
-    setFrequency(getRealFrequency()); // Fixes station found.
+    } while (!poll());
+
+    if (showFunc != NULL && this->currentFrequency != lastFrequency)
+        showFunc();
+}
+
+/**
+ * @ingroup GA03
+ * @brief Starts a seek and returns immediately
+ * @details Call poll() until it returns true to finish the operation. While seeking, poll() updates the current frequency (see getFrequency)
+ * @details and calls the seek event handler (see setSeekEventHandler) on each new channel and at the end of the seek.
+ * @details When the seek finishes, the device is already tuned on the station found. There is no need to tune it again.
+ * @details If a tune or seek is in progress, the new seek starts as soon as it finishes (from the channel reached). A seek in progress is aborted.
+ * @code
+ * rx.seekAsync(SI470X_SEEK_WRAP, SI470X_SEEK_UP);
+ * .
+ * .
+ * void loop() {
+ *   rx.poll();
+ *   if (encoderMoved && rx.isSeeking())
+ *      rx.cancelSeek();
+ * }
+ * @endcode
+ * @see seek, poll, cancelSeek, setSeekEventHandler, getSeekStats
+ * @param seek_mode  Seek Mode; 0 = Wrap at the upper or lower band limit and continue seeking (default); 1 = Stop seeking at the upper or lower band limit.
+ * @param direction  Seek Direction; 0 = Seek down (default); 1 = Seek up.
+ */
+void SI470X::seekAsync(uint8_t seek_mode, uint8_t direction)
+{
+    if (this->tuneState == SI470X_TUNE_IDLE)
+    {
+        this->pendingChannel = SI470X_NO_CHANNEL; // The EON traffic switch requested by the RDS decoder, if any, is cancelled
+        startSeek(seek_mode, direction);
+        return;
+    }
+
+    this->pendingChannel = SI470X_NO_CHANNEL; // The latest request wins
+    this->pendingSeek = ((seek_mode & 1) << 1) | (direction & 1);
+    cancelSeek();
+}
+
+/**
+ * @ingroup GA03
+ * @brief Aborts the seek in progress
+ * @details The device stays on the latest channel reached by the seek. The seek event handler receives SI470X_SEEK_EVENT_CANCELLED.
+ * @details Calling setFrequencyAsync, setChannelAsync or seekAsync during a seek also aborts it.
+ * @see seekAsync, isSeeking
+ * @return true if a seek was aborted
+ */
+bool SI470X::cancelSeek()
+{
+    if (!isSeeking())
+        return false;
+
+    // A seek may be aborted by setting SEEK = 0. READCHAN shows where it stopped.
+    reg02->refined.SEEK = 0;
+    reg03->refined.TUNE = 0;
+    setAllRegisters();
+    getRegisters(2);
+    this->currentFrequency = channelToFrequency(reg0b->refined.READCHAN);
+    this->tuneState = SI470X_TUNE_WAIT_CLEAR;
+#if SI470X_SEEK_STATS
+    this->seekStats.cancelled++;
+#endif
+    if (this->seekEventHandler != NULL)
+        this->seekEventHandler(SI470X_SEEK_EVENT_CANCELLED, this->currentFrequency);
+    return true;
+}
+
+/**
+ * @ingroup GA03
+ * @brief Updates the frequency and the seek statistics when STC is set during a seek
+ * @param event SI470X_SEEK_EVENT_FOUND or SI470X_SEEK_EVENT_FAILED
+ */
+void SI470X::seekFinished(uint8_t event)
+{
+    this->currentFrequency = channelToFrequency(reg0b->refined.READCHAN);
+
+#if SI470X_SEEK_STATS
+    unsigned long elapsed = millis() - this->tuneStart;
+    uint16_t t = (elapsed > 0xFFFF) ? 0xFFFF : elapsed;
+
+    if (event == SI470X_SEEK_EVENT_FOUND)
+        this->seekStats.found++;
+    else
+        this->seekStats.failed++;
+    this->seekStats.lastTime = t;
+    this->seekStats.totalTime += t;
+    if (t < this->seekStats.minTime)
+        this->seekStats.minTime = t;
+    if (t > this->seekStats.maxTime)
+        this->seekStats.maxTime = t;
+#endif
+
+    if (this->seekEventHandler != NULL)
+        this->seekEventHandler(event, this->currentFrequency);
 }
 
 /**
@@ -719,43 +1311,221 @@ void SI470X::setFmDeemphasis(uint8_t de)
  */
 void SI470X::getRdsStatus()
 {
-    word16_to_bytes aux;
-    int i;
-
-    Wire.requestFrom(this->deviceAddress, 12);
-    delayMicroseconds(300);
-    // while (Wire.available() < 32); // It did not work on Attiny Core
-    // The registers from 0x0A to 0x0F come first
-    for (i = 0x0A; i <= 0x0F; i++)
-    {
-        aux.refined.highByte = Wire.read();
-        aux.refined.lowByte = Wire.read();
-        shadowRegisters[i] = aux.raw;
-    }
+    getRegisters(6);
 }
 
 /**
  * @ingroup GA04
- * @brief Sets the Rds Mode Standard or Verbose
- * 
- * @param rds_mode  0 = Standard (default); 1 = Verbose
+ * @brief Reads a new RDS group (if any) and stores it in the RDS FIFO
+ * @details The RDS groups come every 87.6 ms and the device keeps only the latest one. Call this function often
+ * @details (from the loop and inside long tasks like display updates) and process the groups later with getRdsGroup.
+ * @details If the GPIO2 is connected to an interrupt pin (rdsInterruptPin, see setup), it does not use the I2C bus until the device signals a new group.
+ * @details Otherwise, it reads the status register (0x0A) and the RDS registers only if RDSR is set.
+ * @details Groups lost because the FIFO was full or because the device received a new group before the capture are counted. See getRdsFifoStats.
+ * @details If a recorder is set (see setRdsRecorder), each new group is also passed to it, even if the FIFO is full.
+ * @details Nothing is captured while the AF follow mode is trying the Alternative Frequencies (see isRdsAfSearching).
+ * @code
+ * void loop() {
+ *   si470x_rds_group group;
+ *   rx.rdsCapture();
+ *   while (rx.getRdsGroup(&group)) {
+ *     // Process the group
+ *   }
+ * }
+ * @endcode
+ * @see getRdsGroup, getRdsGroupCount, getRdsFifoStats, SI470X_RDS_FIFO_SIZE
+ * @return true if a new group was stored
  */
-void SI470X::setRdsMode(uint8_t rds_mode)
+bool SI470X::rdsCapture()
 {
-    reg02->refined.RDSM = rds_mode; // If true, it has not be disabled
-    setAllRegisters();
-}
+    uint8_t pulses = 1;
+    si470x_rds_group *group;
+    si470x_rds_group raw;
 
-/**
+    if (isRdsAfSearching())
+        return false; // The groups of the Alternative Frequencies belong to the probe
+
+    if (isRdsInterruptEnabled())
+    {
+        if (this->rdsPulses == 0)
+            return false;
+        noInterrupts();
+        pulses = this->rdsPulses;
+        this->rdsPulses = 0;
+        interrupts();
+    }
+    else
+    {
+        getStatus();
+        if (!reg0a->refined.RDSR)
+            return false;
+    }
+
+    getRdsStatus(); // With interrupt, each pulse is a new group even if RDSR is already low (late capture)
+
+    group = &this->rdsFifo[(uint8_t)(this->rdsFifoHead - 1) & (SI470X_RDS_FIFO_SIZE - 1)]; // Zeros before the first group
+    if (!isRdsInterruptEnabled() && (millis() - this->rdsCaptureTime) < SI470X_RDS_GROUP_TIME &&
+        group->blockA == shadowRegisters[REG0C] && group->blockB == shadowRegisters[REG0D] &&
+        group->blockC == shadowRegisters[REG0E] && group->blockD == shadowRegisters[REG0F])
+        return false; // RDSR is still set for the group already stored
+
+#if SI470X_RDS_FIFO_STATS
+    if (pulses > 1)
+        this->rdsFifoStats.missed += pulses - 1;
+#else
+    (void)pulses;
+#endif
+
+    raw.blockA = shadowRegisters[REG0C];
+    raw.blockB = shadowRegisters[REG0D];
+    raw.blockC = shadowRegisters[REG0E];
+    raw.blockD = shadowRegisters[REG0F];
+    raw.bler = (reg0a->refined.BLERA << 6) | (reg0b->refined.BLERB << 4) | (reg0b->refined.BLERC << 2) | reg0b->refined.BLERD;
+
+    if (this->rdsRecorder != NULL)
+    {
+        uint8_t record[SI470X_RDS_RECORD_SIZE];
+        unsigned long elapsed = millis() - this->rdsRecordTime;
+
+        encodeRdsRecord(&raw, (elapsed > 0xFFFF) ? 0xFFFF : elapsed, record);
+        this->rdsRecordTime += elapsed;
+        this->rdsRecorder(record, SI470X_RDS_RECORD_SIZE); // Even if the FIFO is full
+    }
+
+    uint8_t used = this->rdsFifoHead - this->rdsFifoTail;
+    if (used >= SI470X_RDS_FIFO_SIZE)
+    {
+#if SI470X_RDS_FIFO_STATS
+        this->rdsFifoStats.dropped++;
+#endif
+        return false;
+    }
+
+    this->rdsFifo[this->rdsFifoHead & (SI470X_RDS_FIFO_SIZE - 1)] = raw;
+    this->rdsFifoHead++; // Published after the group is complete
+
+    this->rdsCaptureTime = millis();
+#if SI470X_RDS_FIFO_STATS
+    this->rdsFifoStats.received++;
+    if (used + 1 > this->rdsFifoStats.maxUsed)
+        this->rdsFifoStats.maxUsed = used + 1;
+#endif
+    return true;
+}
+
+/**
+ * @ingroup GA04
+ * @brief Converts an RDS group to the recorder format (see setRdsRecorder and SI470X_RDS_RECORD_SIZE)
+ * @param group  group
+ * @param delta  time in ms since the previous group
+ * @param record  receives SI470X_RDS_RECORD_SIZE bytes
+ */
+void SI470X::encodeRdsRecord(const si470x_rds_group *group, uint16_t delta, uint8_t *record)
+{
+    uint16_t values[5] = {delta, group->blockA, group->blockB, group->blockC, group->blockD};
+
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        *record++ = values[i] >> 8;
+        *record++ = values[i] & 0xFF;
+    }
+    *record = group->bler;
+}
+
+/**
+ * @ingroup GA04
+ * @brief Converts a recorded RDS group (see setRdsRecorder and SI470X_RDS_RECORD_SIZE)
+ * @param record  SI470X_RDS_RECORD_SIZE bytes
+ * @param group  receives the group
+ * @return time in ms since the previous group
+ */
+uint16_t SI470X::decodeRdsRecord(const uint8_t *record, si470x_rds_group *group)
+{
+    uint16_t values[5];
+
+    for (uint8_t i = 0; i < 5; i++, record += 2)
+        values[i] = (record[0] << 8) | record[1];
+    group->blockA = values[1];
+    group->blockB = values[2];
+    group->blockC = values[3];
+    group->blockD = values[4];
+    group->bler = *record;
+    return values[0];
+}
+
+/**
+ * @ingroup GA04
+ * @brief Gets the oldest RDS group stored in the RDS FIFO
+ * @details It does not use the I2C bus.
+ * @see rdsCapture, getRdsGroupCount
+ * @param group  receives the group
+ * @return false if the FIFO is empty
+ */
+bool SI470X::getRdsGroup(si470x_rds_group *group)
+{
+    if (this->rdsFifoHead == this->rdsFifoTail)
+        return false;
+    *group = this->rdsFifo[this->rdsFifoTail & (SI470X_RDS_FIFO_SIZE - 1)];
+    this->rdsFifoTail++;
+    return true;
+}
+
+/**
+ * @ingroup GA04
+ * @brief Sets the highest error level accepted for each RDS block
+ * @details The device reports the number of errors corrected in each block (BLERA to BLERD). Blocks above the threshold are
+ * @details discarded before reaching the RDS buffers: if block B fails, the whole group is ignored; otherwise only the data of the failed blocks.
+ * @details The error levels are only reported in verbose mode, so it is enabled (RDSM = 1) when a threshold below 3 is set and
+ * @details by setRds(true). Calling setRdsMode(RDS_STANDARD) afterwards turns the filter off (the device reports no errors).
+ * @details Default: 2 for all blocks (only uncorrectable blocks are discarded).
+ *
+ * | Threshold | Blocks accepted |
+ * | --------- | --------------- |
+ * |     0     | no errors |
+ * |     1     | up to 2 corrected errors |
+ * |     2     | up to 5 corrected errors |
+ * |     3     | all (even uncorrectable blocks) |
+ *
+ * @see getRdsBlockStats, setRdsMode
+ * @param blockA  threshold for the block A (PI)
+ * @param blockB  threshold for the block B (group type)
+ * @param blockC  threshold for the block C
+ * @param blockD  threshold for the block D
+ */
+void SI470X::setRdsErrorThreshold(uint8_t blockA, uint8_t blockB, uint8_t blockC, uint8_t blockD)
+{
+    this->rdsErrorThreshold = ((blockA & 3) << 6) | ((blockB & 3) << 4) | ((blockC & 3) << 2) | (blockD & 3);
+    if (this->rdsErrorThreshold != 0xFF)
+        setRdsMode(RDS_VERBOSE);
+}
+
+/**
+ * @ingroup GA04
+ * @brief Sets the Rds Mode Standard or Verbose
+ * @details setRds(true) selects the verbose mode, unless the error threshold is 3 for all blocks (see setRdsErrorThreshold).
+ * 
+ * @param rds_mode  0 = Standard (default); 1 = Verbose
+ */
+void SI470X::setRdsMode(uint8_t rds_mode)
+{
+    reg02->refined.RDSM = rds_mode; // If true, it has not be disabled
+    setAllRegisters();
+}
+
+/**
  * @ingroup GA04
  * @brief Sets the RDS operation 
  * @details Enable or Disable the RDS
+ * @details When turned on, the verbose mode (RDSM = 1) is also selected, so the device reports the errors of each block and the
+ * @details error threshold works (see setRdsErrorThreshold). It is kept in standard mode if the threshold accepts all blocks (3).
  * 
  * @param true = turns the RDS ON; false  = turns the RDS OFF
  */
 void SI470X::setRds(bool value)
 {
     reg04->refined.RDS = value;
+    if (value && this->rdsErrorThreshold != 0xFF)
+        reg02->refined.RDSM = RDS_VERBOSE; // Same write as RDS
     setAllRegisters();
 }
 
@@ -766,12 +1536,13 @@ void SI470X::setRds(bool value)
  * @details If in verbose mode, the BLERA bits indicate how many errors were corrected in block A. If BLERA indicates 6 or more errors, the data in RDSA should be discarded.
  * @details When using the polling method, it is best not to poll continuously. The data will appear in intervals of ~88 ms and the RDSR indicator will be available for at least 40 ms, so a polling rate of 40 ms or less should be sufficient.
  * @details ATTENTION:  You most call this function before quering other RDS functions. Call it before calling a set of RDS functions. 
+ * @details It is the same as processRdsGroup: the new group is read once and decoded, so the RDS query functions do not use the I2C bus.
+ * @see processRdsGroup
  * @return true or false
  */
 bool SI470X::getRdsReady()
 {
-    getStatus();
-    return reg0a->refined.RDSR;
+    return processRdsGroup();
 };
 
 /**
@@ -820,6 +1591,7 @@ uint8_t SI470X::getRdsVersionCode(void)
  * @brief Returns the Program Type (extracted from the Block B)
  * @details Please, check if getRdsReady was called before.
  * @see https://en.wikipedia.org/wiki/Radio_Data_System
+ * @see getRdsProgramTypeName
  * @return program type (an integer betwenn 0 and 31)
  */
 uint8_t SI470X::getRdsProgramType(void)
@@ -829,6 +1601,63 @@ uint8_t SI470X::getRdsProgramType(void)
     return blkb.refined.programType;
 }
 
+/**
+ * Program Type names (16 characters). See EN 50067 Annex F (RDS) and NRSC-4 (RBDS).
+ */
+#if defined(SI470X_RBDS)
+static const char ptyNames[32][SI470X_RDS_PTY_NAME_SIZE] PROGMEM = {
+    "None", "News", "Information", "Sports", "Talk", "Rock", "Classic Rock", "Adult Hits",
+    "Soft Rock", "Top 40", "Country", "Oldies", "Soft", "Nostalgia", "Jazz", "Classical",
+    "Rhythm and Blues", "Soft R & B", "Foreign Language", "Religious Music", "Religious Talk", "Personality", "Public", "College",
+    "Spanish Talk", "Spanish Music", "Hip Hop", "Unassigned", "Unassigned", "Weather", "Emergency Test", "Emergency"};
+#else
+static const char ptyNames[32][SI470X_RDS_PTY_NAME_SIZE] PROGMEM = {
+    "None", "News", "Current Affairs", "Information", "Sport", "Education", "Drama", "Culture",
+    "Science", "Varied", "Pop Music", "Rock Music", "Easy Listening", "Light Classical", "Serious Classics", "Other Music",
+    "Weather", "Finance", "Children's Progs", "Social Affairs", "Religion", "Phone In", "Travel", "Leisure",
+    "Jazz Music", "Country Music", "National Music", "Oldies Music", "Folk Music", "Documentary", "Alarm Test", "Alarm"};
+#endif
+
+/**
+ * @ingroup GA04
+ * @brief Gets the name of a Program Type in the program memory (flash)
+ * @details No RAM is used. On AVR, print it with the F() string helper type.
+ * @code
+ * Serial.print((const __FlashStringHelper *)rx.getRdsProgramTypeNameP(rx.getRdsProgramType()));
+ * @endcode
+ * @param pty  Program Type (0 to 31)
+ * @return pointer to the name in the program memory
+ */
+const char *SI470X::getRdsProgramTypeNameP(uint8_t pty)
+{
+    return ptyNames[pty & 0x1F];
+}
+
+/**
+ * @ingroup GA04
+ * @brief Copies the name of a Program Type to a buffer
+ * @details RDS (Europe) names, or RBDS (North America) names if SI470X_RBDS is defined.
+ * @param pty  Program Type (0 to 31)
+ * @param buffer  at least SI470X_RDS_PTY_NAME_SIZE bytes
+ * @return buffer
+ */
+char *SI470X::getRdsProgramTypeName(uint8_t pty, char *buffer)
+{
+    return strcpy_P(buffer, ptyNames[pty & 0x1F]);
+}
+
+/**
+ * @ingroup GA04
+ * @brief Copies the name of the Program Type of the tuned station to a buffer
+ * @details It does not use the I2C bus. The PTY comes from the latest group processed (see processRdsGroup).
+ * @param buffer  at least SI470X_RDS_PTY_NAME_SIZE bytes
+ * @return buffer or NULL if no group was received
+ */
+char *SI470X::getRdsProgramTypeName(char *buffer)
+{
+    return (this->rdsPty != 0xFF) ? getRdsProgramTypeName(this->rdsPty, buffer) : NULL;
+}
+
 /**
  * @ingroup GA04
  * 
@@ -867,248 +1696,1653 @@ void SI470X::getNext4Block(char *c)
 
 /**
  * @ingroup GA04
- * @brief Gets the RDS Text when the message is of the Group Type 2 version A
- * @details Please, check if getRdsReady was called before.
- * @return char*  The string (char array) with the content (Text) received from group 2A 
+ * @brief Reads the RDS group (if any) and updates all RDS buffers
+ * @details It reads the status register (0x0A) and, only if there is a new group, the RDS registers (0x0A to 0x0F), once.
+ * @details The group (and the ones waiting in the RDS FIFO) is decoded by type and version: 0A/0B to the station name (PS),
+ * @details 2A/2B to the radio text (RT) and 4A to the clock time (CT).
+ * @details After that, getRdsStationName, getRdsProgramInformation, getRdsStationInformation, getRdsTime and getRdsLocalTime
+ * @details just return the buffers. They do not use the I2C bus.
+ * @code
+ * void loop() {
+ *   if (rx.processRdsGroup()) {
+ *     showStationName(rx.getRdsStationName());
+ *     showProgramInfo(rx.getRdsProgramInformation());
+ *   }
+ * }
+ * @endcode
+ * @see rdsCapture, getRdsReady
+ * @return true if at least one group was decoded
  */
-char *SI470X::getRdsText(void)
+bool SI470X::processRdsGroup()
 {
-    static int rdsTextAdress2A;
-    si470x_rds_blockb blkb;
-
-    getRdsStatus();
-
-    blkb.blockB = shadowRegisters[0x0D];
-    rdsTextAdress2A = blkb.group2.address;
-
-    if (rdsTextAdress2A >= 16)
-        rdsTextAdress2A = 0;
+    si470x_rds_group group;
+    bool decoded = false;
 
-    getNext4Block(&rds_buffer2A[rdsTextAdress2A * 4]);
-    rdsTextAdress2A += 4;
-    return rds_buffer2A;
+    rdsCapture();
+    while (getRdsGroup(&group))
+    {
+        processRdsGroup(&group);
+        decoded = true;
+    }
+    return decoded;
 }
 
 /**
  * @ingroup GA04
- * @todo RDS Dynamic PS or Scrolling PS support
- * @details Please, check if getRdsReady was called before.
- * @brief Gets the station name and other messages. 
- * 
- * @return char* should return a string with the station name. 
- *         However, some stations send other kind of messages
+ * @brief Decodes a given RDS group and updates the RDS buffers
+ * @details It does not use the I2C bus. Use it to decode groups from other sources (for example, groups recorded before).
+ * @param group  RDS group
  */
-char *SI470X::getRdsText0A(void)
+void SI470X::processRdsGroup(const si470x_rds_group *group)
 {
-    static int rdsTextAdress0A;
     si470x_rds_blockb blkb;
+    uint8_t valid = 0;
+    uint8_t code;
 
-    getRdsStatus();
-    blkb.blockB = shadowRegisters[0x0D];
+    // Block errors against the thresholds: A, B, C and D from the upper to the lower bits
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        uint8_t shift = 6 - i * 2;
+        valid <<= 1;
+        if (((group->bler >> shift) & 3) <= ((this->rdsErrorThreshold >> shift) & 3))
+        {
+            valid |= 1;
+#if SI470X_RDS_BLOCK_STATS
+            this->rdsBlockStats.accepted[i]++;
+#endif
+        }
+#if SI470X_RDS_BLOCK_STATS
+        else
+            this->rdsBlockStats.rejected[i]++;
+#endif
+    }
+    countRdsGroup(group, valid);
 
-    if (blkb.group0.groupType == 0)
+    if (valid & SI470X_RDS_BLOCK_A)
     {
-        // Process group type 0
-        rdsTextAdress0A = blkb.group0.address;
-        if (rdsTextAdress0A >= 0 && rdsTextAdress0A < 4)
+#if SI470X_RDS_CACHE_SIZE > 0
+        if (this->rdsCacheLookup)
         {
-            getNext2Block(&rds_buffer0A[rdsTextAdress0A * 2]);
-            rds_buffer0A[8] = '\0';
-            return rds_buffer0A;
+            this->rdsCacheLookup = false;
+            loadRdsCache(group->blockA);
         }
+#endif
+        processRdsPi(group->blockA);
     }
-    return NULL;
-}
 
-/**
- * @ingroup @ingroup GA04
- * 
- * @brief Gets the Text processed for the 2A group
- * 
- * @return char* string with the Text of the group A2  
- */
-char *SI470X::getRdsText2A(void)
-{
-    static int rdsTextAdress2A;
-    si470x_rds_blockb blkb;
+    if (!(valid & SI470X_RDS_BLOCK_B))
+        return; // The group type is not reliable
 
-    getRdsStatus();
+    blkb.blockB = group->blockB;
+    if (blkb.refined.versionCode && (valid & SI470X_RDS_BLOCK_C))
+        processRdsPi(group->blockC); // Version B groups repeat the PI code in the block C
 
-    blkb.blockB = shadowRegisters[0x0D];
-    rdsTextAdress2A = blkb.group2.address;
-    if (blkb.group2.groupType == 2)
+    if (blkb.refined.programType != this->rdsPty)
     {
-        // Process group 2A
-        // Decode B block information
-        if (rdsTextAdress2A >= 0 && rdsTextAdress2A < 16)
-        {
-            getNext4Block(&rds_buffer2A[rdsTextAdress2A * 4]);
-            rds_buffer2A[63] = '\0';
-            return rds_buffer2A;
-        }
+        this->rdsPty = blkb.refined.programType;
+#if SI470X_RDS_CALLBACKS
+        if (this->ptyHandler != NULL)
+            this->ptyHandler(this->rdsPty);
+#endif
     }
-    return NULL;
+
+    code = SI470X_RDS_GROUP(blkb.refined.groupType, blkb.refined.versionCode);
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    if (code == this->rdsRtPlusGroup)
+        processRdsRtPlus(group, valid);
+#endif
+    switch (blkb.refined.groupType)
+    {
+    case 0:
+        processRdsGroup0(group, valid);
+        break;
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PIN)
+    case 1:
+        processRdsGroup1(group, valid);
+        break;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    case 2:
+        processRdsGroup2(group, valid);
+        break;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_ODA)
+    case 3:
+        if (blkb.refined.versionCode == 0)
+            processRdsGroup3A(group, valid);
+        break;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
+    case 4:
+        if (blkb.refined.versionCode == 0)
+            processRdsGroup4A(group, valid);
+        break;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PTYN)
+    case 10:
+        if (blkb.refined.versionCode == 0)
+            processRdsGroup10A(group, valid);
+        break;
+#endif
+#if SI470X_RDS_EON_SIZE > 0
+    case 14:
+        processRdsGroup14(group, valid);
+        break;
+#endif
+    }
+    callRdsHandlers(code, group, valid);
 }
 
 /**
  * @ingroup GA04
- * @brief Gets the Text processed for the 2B group
- * @return char* string with the Text of the group AB  
+ * @brief Updates the RDS statistics with a group (see getRdsStats)
+ * @param group  group
+ * @param valid  valid block mask
  */
-char *SI470X::getRdsText2B(void)
+void SI470X::countRdsGroup(const si470x_rds_group *group, uint8_t valid)
 {
-    static int rdsTextAdress2B;
-    si470x_rds_blockb blkb;
-
-    getRdsStatus();
-    blkb.blockB = shadowRegisters[0x0D];
-    if (blkb.group2.groupType == 2)
+#if SI470X_RDS_STATS
+    for (uint8_t i = 0; i < 4; i++)
+        this->rdsStats.bler[i][(group->bler >> (6 - i * 2)) & 3]++;
+    this->rdsStats.groups++;
+    if (valid & SI470X_RDS_BLOCK_B)
     {
-        // Process group 2B
-        rdsTextAdress2B = blkb.group2.address;
-        if (rdsTextAdress2B >= 0 && rdsTextAdress2B < 16)
-        {
-            getNext2Block(&rds_buffer2B[rdsTextAdress2B * 2]);
-            return rds_buffer2B;
-        }
+        this->rdsStats.groupTypes[group->blockB >> 12]++;
+        if (group->blockB & 0x0800)
+            this->rdsStats.versionB++;
     }
-    return NULL;
+    if (valid == (SI470X_RDS_BLOCK_A | SI470X_RDS_BLOCK_B | SI470X_RDS_BLOCK_C | SI470X_RDS_BLOCK_D))
+    {
+        this->rdsStats.validGroups++;
+        this->rdsValidTime = millis();
+    }
+    this->rdsRateGroups++;
+    updateRdsRate();
+#else
+    (void)group;
+    (void)valid;
+#endif
 }
 
 /**
- * @ingroup GA04 
- * @brief Gets the RDS time and date when the Group type is 4 
- * @return char* a string with hh:mm +/- offset
+ * @ingroup GA04
+ * @brief Updates the group rate when the measurement period (SI470X_RDS_RATE_WINDOW) is over
  */
-char *SI470X::getRdsTime()
+void SI470X::updateRdsRate()
 {
-    // Under Test and construction
-    // Need to check the Group Type before.
-    si470x_rds_date_time dt;
-    word16_to_bytes blk_b, blk_c, blk_d;
-    si470x_rds_blockb blkb;
-
-    getRdsStatus();
+#if SI470X_RDS_STATS
+    unsigned long elapsed = millis() - this->rdsRateStart;
 
-    blk_b.raw = blkb.blockB = shadowRegisters[REG0D];
-    blk_c.raw = shadowRegisters[REG0E];
-    blk_d.raw = shadowRegisters[REG0F];
+    if (elapsed < SI470X_RDS_RATE_WINDOW)
+        return;
+    this->rdsStats.groupRate = (uint32_t)this->rdsRateGroups * 10000UL / elapsed;
+    this->rdsRateGroups = 0;
+    this->rdsRateStart = millis();
+#endif
+}
 
-    uint16_t minute;
-    uint16_t hour;
+/**
+ * @ingroup GA04
+ * @brief Gets the RDS reception statistics
+ * @details Groups per type, block error histogram (BLERA to BLERD), synchronization losses, group rate and time since the
+ * @details latest valid group. Everything is updated by the RDS decoder and by the status reads that the library already does:
+ * @details this function does not use the I2C bus. A good signal gives about 11.4 groups per second with few block errors;
+ * @details a low rate with many errors points to the antenna or the signal, while a good rate with no valid groups points to the station.
+ * @code
+ * si470x_rds_stats stats = rx.getRdsStats();
+ * Serial.print(stats.groupRate / 10.0);
+ * Serial.print(" groups/s, 2A: ");
+ * Serial.println(stats.groupTypes[2]);
+ * @endcode
+ * @see resetRdsStats, getRdsBlockStats, getRdsFifoStats, SI470X_RDS_STATS
+ * @return si470x_rds_stats (all zeros if SI470X_RDS_STATS is 0)
+ */
+si470x_rds_stats SI470X::getRdsStats()
+{
+    si470x_rds_stats stats;
+
+#if SI470X_RDS_STATS
+    updateRdsRate();
+    stats = this->rdsStats;
+    stats.lastValidAge = (stats.validGroups != 0) ? millis() - this->rdsValidTime : 0xFFFFFFFF;
+#else
+    memset(&stats, 0, sizeof(stats));
+#endif
+    return stats;
+}
 
-    if ( blkb.group0.groupType  == 4)
-    {
-        char offset_sign;
-        int offset_h;
-        int offset_m;
+/**
+ * @ingroup GA04
+ * @brief Resets the RDS reception statistics (for example, after tuning a new station)
+ */
+void SI470X::resetRdsStats()
+{
+#if SI470X_RDS_STATS
+    memset(&this->rdsStats, 0, sizeof(this->rdsStats));
+    this->rdsRateGroups = 0;
+    this->rdsRateStart = millis();
+#endif
+}
 
-        // uint16_t y, m, d;
+/**
+ * @ingroup GA04
+ * @brief Decodes the groups 0A and 0B (station name, two characters per group)
+ * @details The segments are assembled in a work buffer. The name is published (rds_buffer0A) only when the four segments
+ * @details were received (twice with the same content if setRdsStationNameConfirm(true)), so the previous name stays visible meanwhile.
+ * @param group  RDS group
+ * @param valid  blocks with acceptable errors (SI470X_RDS_BLOCK_A to SI470X_RDS_BLOCK_D)
+ */
+void SI470X::processRdsGroup0(const si470x_rds_group *group, uint8_t valid)
+{
+    si470x_rds_blockb blkb;
 
-        dt.raw[4] = blk_b.refined.lowByte;
-        dt.raw[5] = blk_b.refined.highByte;
+    blkb.blockB = group->blockB;
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    if (blkb.group0.versionCode == 0 && (valid & SI470X_RDS_BLOCK_C))
+        processRdsAf(group->blockC >> 8, group->blockC & 0xFF);
+#endif
+
+#if SI470X_RDS_TRAFFIC
+    bool ta = blkb.group0.trafficProgramCode && blkb.group0.TA;
+    if (ta && this->trafficReturnFrequency != 0)
+        this->trafficConfirmed = true;
+    if (ta != this->rdsTrafficAnnouncement)
+        updateTrafficAnnouncement(ta);
+#endif
+
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PS)
+    word16_to_bytes blk_d;
+    char *c;
+    bool same;
+
+    if (!(valid & SI470X_RDS_BLOCK_D))
+        return;
 
-        dt.raw[2] = blk_c.refined.lowByte;
-        dt.raw[3] = blk_c.refined.highByte;
+    blk_d.raw = group->blockD;
+    c = &rdsPsWork[blkb.group0.address * 2];
+    same = c[0] == (char)blk_d.refined.highByte && c[1] == (char)blk_d.refined.lowByte;
+    c[0] = blk_d.refined.highByte;
+    c[1] = blk_d.refined.lowByte;
 
-        dt.raw[0] = blk_d.refined.lowByte;
-        dt.raw[1] = blk_d.refined.highByte;
+    if (same || !this->rdsPsConfirm)
+        this->rdsPsReady |= 1 << blkb.group0.address;
+    else
+        this->rdsPsReady &= ~(1 << blkb.group0.address);
 
-        minute =  dt.refined.minute;
-        hour = dt.refined.hour;
+    if (this->rdsPsReady != 0x0F)
+        return;
 
-        offset_sign = (dt.refined.offset_sense == 1) ? '+' : '-';
-        offset_h = (dt.refined.offset * 30) / 60;
-        offset_m = (dt.refined.offset * 30) - (offset_h * 60);
+    this->rdsPsReady = 0; // Starts assembling the next one
+    if (memcmp(rds_buffer0A, rdsPsWork, 8) != 0)
+    {
+        memcpy(rds_buffer0A, rdsPsWork, 8);
+        rds_buffer0A[8] = '\0';
+        this->rdsPsVersion++;
+#if SI470X_RDS_CALLBACKS
+        if (this->programServiceHandler != NULL)
+            this->programServiceHandler(rds_buffer0A);
+#endif
+    }
+    this->rdsPsPi = (this->rdsPi != 0) ? this->rdsPi : this->rdsPiCandidate;
+#else
+    (void)blkb;
+    (void)valid;
+#endif
+}
 
-        // If wrong time, return NULL
-        if (offset_h > 12 || offset_m > 60 || hour > 24 || minute > 60)
-            return NULL;
+/**
+ * @ingroup GA04
+ * @brief Decodes the groups 2A (four characters per group) and 2B (two characters per group) of the radio text
+ * @details The segments are assembled in a work buffer that is reset when the Text A/B flag toggles (new message) or the version changes.
+ * @details The message is complete when all segments up to the end of the text (carriage return, 0x0D) or all the 16 segments were received.
+ * @details The end is searched again in each repetition, so a corrupted character taken as 0x0D only cuts one of them. A 0x0D at the first position is an empty text.
+ * @details Then it is published: rds_buffer2A (2A, up to 64 characters) or rds_buffer2B (2B, up to 32 characters).
+ * @details Without the work buffer (SI470X_RDS_RT_WORK = 0), the text is assembled in rds_buffer2A/rds_buffer2B and shows up as it arrives.
+ * @details Each block carries two characters. Characters of valid blocks are stored, but a segment only counts if all its blocks are valid.
+ * @param group  RDS group
+ * @param valid  blocks with acceptable errors (SI470X_RDS_BLOCK_A to SI470X_RDS_BLOCK_D)
+ */
+void SI470X::processRdsGroup2(const si470x_rds_group *group, uint8_t valid)
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    si470x_rds_blockb blkb;
+    word16_to_bytes blk_c, blk_d;
+    uint8_t size, address, i, segments;
+    char text[4];
+    char *buffer, *work;
+    bool changed;
+
+    blkb.blockB = group->blockB;
+    blk_c.raw = group->blockC;
+    blk_d.raw = group->blockD;
+    address = blkb.group2.address;
+    size = (blkb.group2.versionCode == 0) ? 4 : 2;
+    buffer = (size == 4) ? rds_buffer2A : rds_buffer2B;
+#if SI470X_RDS_RT_WORK
+    work = rdsRtWork;
+#else
+    work = buffer;
+#endif
+
+    if (blkb.group2.textABFlag != this->rdsRtFlagAB || blkb.group2.versionCode != this->rdsRtVersionCode)
+    {
+        // New message: with the work buffer, the previous one stays published until the new one is complete
+#if SI470X_RDS_RT_WORK
+        memset(rdsRtWork, ' ', sizeof(rdsRtWork));
+#else
+        if (this->rdsRtFlagAB != 0xFF) // Keeps the text restored from the cache (see loadRdsCache)
+            memset(buffer, 0, size * 16 + 1);
+        this->rdsRtChanged = true;
+#endif
+        this->rdsRtSegments = 0;
+        this->rdsRtEnd = 64;
+        this->rdsRtFlagAB = blkb.group2.textABFlag;
+        this->rdsRtVersionCode = blkb.group2.versionCode;
+    }
 
-        this->convertToChar(hour, rds_time, 2, 0, ' ', false);
-        rds_time[2] = ':';
-        this->convertToChar(minute, &rds_time[3], 2, 0, ' ', false);
-        rds_time[5] = ' ';
-        rds_time[6] = offset_sign;
-        this->convertToChar(offset_h, &rds_time[7], 2, 0, ' ', false);
-        rds_time[9] = ':';
-        this->convertToChar(offset_m, &rds_time[10], 2, 0, ' ', false);
-        rds_time[12] = '\0';
+    if (size == 4)
+    {
+        text[0] = blk_c.refined.highByte;
+        text[1] = blk_c.refined.lowByte;
+        text[2] = blk_d.refined.highByte;
+        text[3] = blk_d.refined.lowByte;
+        if ((valid & SI470X_RDS_BLOCK_C) == 0)
+            text[0] = text[1] = 0;
+        if ((valid & SI470X_RDS_BLOCK_D) == 0)
+            text[2] = text[3] = 0;
+    }
+    else
+    {
+        text[0] = blk_d.refined.highByte;
+        text[1] = blk_d.refined.lowByte;
+        if ((valid & SI470X_RDS_BLOCK_D) == 0)
+            text[0] = text[1] = 0;
+    }
 
-        return rds_time;
+    for (i = 0; i < size; i++)
+    {
+        if (text[i] == 0)
+            continue; // Invalid block
+        if (text[i] == 0x0D)
+        {
+            if ((address * size + i) < this->rdsRtEnd)
+                this->rdsRtEnd = address * size + i;
+            text[i] = '\0'; // Also ends the text assembled in place
+        }
+#if !SI470X_RDS_RT_WORK
+        this->rdsRtChanged |= work[address * size + i] != text[i];
+#endif
+        work[address * size + i] = text[i];
     }
+    if ((size == 4 && (valid & (SI470X_RDS_BLOCK_C | SI470X_RDS_BLOCK_D)) == (SI470X_RDS_BLOCK_C | SI470X_RDS_BLOCK_D)) ||
+        (size == 2 && (valid & SI470X_RDS_BLOCK_D)))
+        this->rdsRtSegments |= 1 << address;
+
+    // Complete: all segments before the end of the text
+    if (this->rdsRtEnd > size * 16)
+        this->rdsRtEnd = size * 16;
+    segments = (this->rdsRtEnd + size - 1) / size;
+    if (segments == 0)
+        segments = 1; // Empty text: the segment with the 0x0D
+    if ((this->rdsRtSegments & (0xFFFF >> (16 - segments))) != (0xFFFF >> (16 - segments)))
+        return;
 
-    return NULL;
+#if SI470X_RDS_RT_WORK
+    changed = strncmp(buffer, rdsRtWork, this->rdsRtEnd) != 0 || buffer[this->rdsRtEnd] != '\0';
+    memcpy(buffer, rdsRtWork, this->rdsRtEnd);
+#else
+    changed = this->rdsRtChanged || buffer[this->rdsRtEnd] != '\0';
+    this->rdsRtChanged = false;
+#endif
+    buffer[this->rdsRtEnd] = '\0';
+    if (changed)
+    {
+        this->rdsRtVersion++;
+#if SI470X_RDS_CALLBACKS
+        if (this->radioTextHandler != NULL)
+            this->radioTextHandler(buffer);
+#endif
+    }
+    this->rdsRtPi = (this->rdsPi != 0) ? this->rdsPi : this->rdsPiCandidate;
+    this->rdsRtSegments = 0; // Starts assembling the next repetition
+    this->rdsRtEnd = 64;
+#else
+    (void)group;
+    (void)valid;
+#endif
 }
 
-
 /**
  * @ingroup GA04
- * @brief Gets the RDS time converted to local time.
- * @details ATTENTION: You must call getRdsReady before calling this function.
- * @details ATTENTION: Some stations broadcast wrong time.
- * @return char* a string with hh:mm
- * @see getRdsReady
+ * @brief Decodes the group 4A (clock time and date). See getRdsClockTime
+ * @details Block B (bits 1-0) and C (bits 15-1): Modified Julian Day; C (bit 0) and D (bits 15-12): UTC hour;
+ * @details D (bits 11-6): UTC minute; D (bit 5): offset sign (1 = negative); D (bits 4-0): local time offset in half hours.
+ * @param group  RDS group
+ * @param valid  blocks with acceptable errors (SI470X_RDS_BLOCK_A to SI470X_RDS_BLOCK_D)
  */
-char *SI470X::getRdsLocalTime()
+void SI470X::processRdsGroup4A(const si470x_rds_group *group, uint8_t valid)
 {
-    // Under Test and construction
-    // Need to check the Group Type before.
-    si470x_rds_date_time dt;
-    word16_to_bytes blk_b, blk_c, blk_d;
-    si470x_rds_blockb blkb;
-
-    getRdsStatus();
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
+    uint32_t mjd;
+    uint8_t hour, minute, offset;
+    bool same;
 
-    blk_b.raw = blkb.blockB = shadowRegisters[REG0D];
-    blk_c.raw = shadowRegisters[REG0E];
-    blk_d.raw = shadowRegisters[REG0F];
+    if ((valid & (SI470X_RDS_BLOCK_C | SI470X_RDS_BLOCK_D)) != (SI470X_RDS_BLOCK_C | SI470X_RDS_BLOCK_D))
+        return; // The date and the time are spread over the blocks B, C and D
 
-    uint16_t minute;
-    uint16_t hour;
-    uint16_t localTime;
+    mjd = ((uint32_t)(group->blockB & 0x03) << 15) | (group->blockC >> 1);
+    hour = ((group->blockC & 0x01) << 4) | (group->blockD >> 12);
+    minute = (group->blockD >> 6) & 0x3F;
+    offset = group->blockD & 0x1F;
 
-    if ( blkb.group0.groupType  == 4)
-    {
-        int offset_h;
-        int offset_m;
+    // Wrong time (some stations broadcast it): ignored. The date conversion is valid from 1900-03-01 (MJD 15079) on.
+    if (hour > 23 || minute > 59 || offset > 24 || mjd < 15080)
+        return;
 
-        dt.raw[4] = blk_b.refined.lowByte;
-        dt.raw[5] = blk_b.refined.highByte;
+    same = this->rdsClockVersion != 0 && this->rdsClockMjd == mjd && this->rdsClockMinutes == (hour * 60 + minute) &&
+           this->rdsClockOffset == ((group->blockD & 0x20) ? -offset : offset);
+    this->rdsClockMjd = mjd;
+    this->rdsClockMinutes = hour * 60 + minute;
+    this->rdsClockOffset = (group->blockD & 0x20) ? -offset : offset;
+    if (++this->rdsClockVersion == 0)
+        this->rdsClockVersion = 1; // 0 means no time received
 
-        dt.raw[2] = blk_c.refined.lowByte;
-        dt.raw[3] = blk_c.refined.highByte;
+#if SI470X_RDS_CALLBACKS
+    if (!same && this->clockTimeHandler != NULL)
+    {
+        si470x_rds_clock_time ct;
+        getRdsClockTime(&ct, true);
+        this->clockTimeHandler(&ct);
+    }
+#else
+    (void)same;
+#endif
+#else
+    (void)group;
+    (void)valid;
+#endif
+}
 
-        dt.raw[0] = blk_d.refined.lowByte;
-        dt.raw[1] = blk_d.refined.highByte;
+/**
+ * @ingroup GA04
+ * @brief Confirms the PI code received in the blocks A (and C of the version B groups)
+ * @details A new PI code is accepted after rdsPiConfirm receptions in a row. The group 1 data, the AF list and the EON list of the previous station are discarded.
+ * @details So are the published name and text sent by another station (for example, the name of the previous station on a station that sends only text).
+ * @param pi  PI code
+ */
+void SI470X::processRdsPi(uint16_t pi)
+{
+    if (pi != this->rdsPiCandidate)
+    {
+        this->rdsPiCandidate = pi;
+        this->rdsPiCount = 0;
+    }
+    if (this->rdsPiCount < this->rdsPiConfirm)
+        this->rdsPiCount++;
 
-        minute =  dt.refined.minute;
-        hour = dt.refined.hour;
+    if (this->rdsPiCount >= this->rdsPiConfirm && this->rdsPi != pi)
+    {
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+        if (this->rdsAfPi != 0 && this->rdsAfPi != pi)
+        {
+            this->rdsAfCount = 0; // The list belongs to the previous station
+            this->afFailed = 0;
+        }
+        this->rdsAfPi = pi;
+#endif
+        this->rdsPi = pi;
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PIN)
+        this->rdsEcc = this->rdsLanguage = 0;
+        this->rdsPin = 0;
+#endif
+#if SI470X_RDS_EON_SIZE > 0
+        this->rdsEonCount = 0;
+#endif
+        if (this->rdsPsPi != pi && rds_buffer0A[0] != '\0')
+        {
+            memset(rds_buffer0A, 0, sizeof(rds_buffer0A));
+            this->rdsPsVersion++;
+        }
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+        if (this->rdsRtPi != pi && (rds_buffer2A[0] != '\0' || rds_buffer2B[0] != '\0'))
+        {
+            memset(rds_buffer2A, 0, sizeof(rds_buffer2A));
+            memset(rds_buffer2B, 0, sizeof(rds_buffer2B));
+            this->rdsRtVersion++;
+        }
+#endif
+    }
+}
 
-        offset_h = (dt.refined.offset * 30) / 60;
-        offset_m = (dt.refined.offset * 30) - (offset_h * 60);
+/**
+ * @ingroup GA04
+ * @brief Decodes the Alternative Frequency codes of the block C of the group 0A
+ * @details Method A: a header (224 + number of AFs) and the list itself. Method B: the header is followed by the tuned
+ * @details frequency and the list is sent in pairs (tuned frequency, AF). A pair in descending order is a regional variant (not stored).
+ * @details A method A list can also start with the tuned frequency: the list is taken as method A as soon as a pair does not have it.
+ * @param code1  first code (high byte)
+ * @param code2  second code (low byte)
+ */
+void SI470X::processRdsAf(uint8_t code1, uint8_t code2)
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    uint8_t tuned = (this->currentFrequency > 8750 && this->currentFrequency <= 10790) ? (this->currentFrequency - 8750) / 10 : 0;
 
-        localTime = (hour * 60 + minute);
-        if (dt.refined.offset_sense == 1)
-            localTime -= (offset_h * 60 + offset_m);
+    if (code1 >= 224 && code1 <= 249)
+    {
+        if (code2 == tuned && code1 > 225)
+            this->rdsAfMethodB = true;
         else
-            localTime += (offset_h * 60 + offset_m);
+            addRdsAf(code2);
+        return;
+    }
+    if (code1 == 250)
+        return; // LF/MF frequency follows
 
-        hour = localTime / 60;
-        minute = localTime - (hour * 60);
+    if (this->rdsAfMethodB && code1 != tuned && code2 != tuned)
+    {
+        this->rdsAfMethodB = false;
+        addRdsAf(tuned);
+    }
+    if (!this->rdsAfMethodB)
+    {
+        addRdsAf(code1);
+        addRdsAf(code2);
+    }
+    else if (code1 < code2)
+        addRdsAf((code1 == tuned) ? code2 : code1);
+#else
+    (void)code1;
+    (void)code2;
+#endif
+}
 
-        if (hour > 24 || minute > 60)
-            return NULL;
+/**
+ * @ingroup GA04
+ * @brief Adds an Alternative Frequency code (1 = 87.6 MHz to 204 = 107.9 MHz) to the list of the current station
+ * @param code  AF code. Filler and special codes are ignored.
+ */
+void SI470X::addRdsAf(uint8_t code)
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    if (code == 0 || code > 204)
+        return;
+    for (uint8_t i = 0; i < this->rdsAfCount; i++)
+        if (this->rdsAf[i] == code)
+            return;
+    if (this->rdsAfCount < SI470X_RDS_AF_SIZE)
+    {
+        this->rdsAf[this->rdsAfCount++] = code;
+        this->afFailed = 0; // New list: every AF gets a new chance
+        this->afCheckInterval = SI470X_AF_CHECK_INTERVAL;
+    }
+#else
+    (void)code;
+#endif
+}
 
-        this->convertToChar(hour, rds_time, 2, 0, ' ', false);
-        rds_time[2] = ':';
-        this->convertToChar(minute, &rds_time[3], 2, 0, ' ', false);
-        rds_time[5] = '\0';
+/**
+ * @ingroup GA04
+ * @brief Excludes the Alternative Frequency being probed until the AF list changes and moves to the next one
+ */
+void SI470X::failRdsAf()
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    this->afFailed |= (uint32_t)1 << this->afIndex;
+    this->afIndex++;
+    this->afState = SI470X_AF_PROBE;
+#endif
+}
 
-        return rds_time;
-    }
+/**
+ * @ingroup GA04
+ * @brief Runs one step of the AF follow mode (see setRdsAfFollow)
+ * @details It never waits and uses the I2C bus at most once per call. poll() calls it while idle. The steps are:
+ * @details 1. Every afCheckInterval ms, it reads the RSSI. If it is below the threshold, the audio is muted and a round starts.
+ * @details 2. The next Alternative Frequency not excluded is tuned (by the tune state machine, see poll).
+ * @details 3. The RSSI and the PI code of the first RDS group are read (up to SI470X_AF_PI_TIMEOUT ms). If the signal is better and the
+ * @details    PI code is the same, the receiver stays there. A wrong PI code or no PI code excludes the AF until the AF list changes.
+ * @details 4. If no AF is better, the receiver goes back to the original frequency and the next round only starts after twice
+ * @details    the previous interval (up to SI470X_AF_CHECK_MAX ms).
+ * @details The RDS information (name, text, ...) is kept: it is the same station. RDS is not captured during the round (see isRdsAfSearching).
+ * @return true if the receiver has just switched to an Alternative Frequency
+ */
+bool SI470X::checkRdsAf()
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    if (this->tuneState != SI470X_TUNE_IDLE)
+        return false;
 
+    switch (this->afState)
+    {
+    case SI470X_AF_IDLE:
+        if (this->rdsPi == 0 || this->rdsAfPi != this->rdsPi || this->rdsAfCount == 0 || isRdsTrafficSwitched())
+            return false; // Only the AF list of the confirmed station is followed
+        if ((millis() - this->afCheckTime) < this->afCheckInterval)
+            return false;
+        this->afCheckTime = millis();
+        getStatus();
+        if (reg0a->refined.RSSI >= this->afRssiThreshold)
+        {
+            this->afCheckInterval = SI470X_AF_CHECK_INTERVAL;
+            return false;
+        }
+        this->afRssi = reg0a->refined.RSSI;
+        this->afReturnFrequency = this->currentFrequency;
+        this->afDmute = reg02->refined.DMUTE;
+        this->afIndex = 0;
+        this->afState = SI470X_AF_PROBE;
+        return false;
+
+    case SI470X_AF_PROBE:
+        while (this->afIndex < this->rdsAfCount &&
+               (((this->afFailed >> this->afIndex) & 1) || getRdsAf(this->afIndex) == this->afReturnFrequency))
+            this->afIndex++;
+        if (this->afIndex < this->rdsAfCount)
+        {
+            reg02->refined.DMUTE = 0; // Written with the tune
+            startTune(frequencyToChannel(getRdsAf(this->afIndex)), SI470X_RETUNE_AF);
+            this->afCheckTime = millis();
+            this->afState = SI470X_AF_WAIT_PI;
+            return false;
+        }
+        // No AF is better: back to the original frequency and longer interval until the next round
+        if (this->afCheckInterval < SI470X_AF_CHECK_MAX)
+            this->afCheckInterval = (this->afCheckInterval > SI470X_AF_CHECK_MAX / 2) ? SI470X_AF_CHECK_MAX : this->afCheckInterval * 2;
+        this->afState = SI470X_AF_UNMUTE;
+        if (this->currentFrequency != this->afReturnFrequency)
+            startTune(frequencyToChannel(this->afReturnFrequency), SI470X_RETUNE_AF);
+        return false;
+
+    case SI470X_AF_WAIT_PI:
+        if ((millis() - this->afCheckTime) >= SI470X_AF_PI_TIMEOUT)
+        {
+            failRdsAf(); // No RDS (or not readable): not the same station
+            return false;
+        }
+        if ((millis() - this->lastPoll) < SI470X_POLL_INTERVAL)
+            return false;
+        this->lastPoll = millis();
+        getRdsStatus();
+        if (reg0a->refined.RSSI <= this->afRssi || reg0a->refined.RSSI < this->afRssiThreshold)
+        {
+            this->afIndex++; // Weak signal: it may be better in the next round
+            this->afState = SI470X_AF_PROBE;
+            return false;
+        }
+        if (!reg0a->refined.RDSR || reg0a->refined.BLERA > (this->rdsErrorThreshold >> 6))
+            return false;
+        if (shadowRegisters[REG0C] != this->rdsPi)
+        {
+            failRdsAf();
+            return false;
+        }
+        if (this->rdsAfMethodB)
+        {
+            this->rdsAfCount = 0; // Each transmitter has its own list
+            this->afFailed = 0;
+        }
+        this->afCheckInterval = SI470X_AF_CHECK_INTERVAL;
+        this->afState = SI470X_AF_UNMUTE;
+        return true;
+
+    default: // SI470X_AF_UNMUTE
+        reg02->refined.DMUTE = this->afDmute;
+        setAllRegisters();
+        this->rdsPulses = 0; // The groups received during the round are not in the RDS FIFO
+        this->afCheckTime = millis();
+        this->afState = SI470X_AF_IDLE;
+        return false;
+    }
+#else
+    return false;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Decodes the group 3A (Open Data Applications)
+ * @details Block D: Application Identification (AID). Block B: group that carries the application data. Block C: application message.
+ * @details The RadioText Plus (AID 0x4BD7) is decoded by the library. The other applications go to the handlers registered by
+ * @details addRdsOdaHandler: the group announced is bound to them and they also receive the group 3A itself.
+ * @details AID 0 is not an application: such a group is ignored and never binds the handlers of fixed groups (addRdsGroupHandler).
+ * @details A group that cannot carry an ODA (see SI470X_RDS_ODA_GROUPS) is a corrupted block B (or 15B, temporary data fault): ignored too.
+ * @param group  group
+ * @param valid  valid block mask
+ */
+void SI470X::processRdsGroup3A(const si470x_rds_group *group, uint8_t valid)
+{
+    uint8_t code;
+
+    if (!(valid & SI470X_RDS_BLOCK_D) || group->blockD == 0)
+        return;
+    code = group->blockB & 0x1F;
+    if (code == 0)
+        code = SI470X_RDS_NO_GROUP; // 00000 = no group: the application uses the group 3A only
+    else if (!((SI470X_RDS_ODA_GROUPS >> code) & 1))
+        return;
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    if (group->blockD == SI470X_RDS_AID_RTPLUS && code != SI470X_RDS_NO_GROUP && (code & 1) == 0)
+        this->rdsRtPlusGroup = code; // The tags need the blocks C and D: version A groups only
+#endif
+#if SI470X_RDS_HANDLER_SIZE > 0
+    bool changed = false;
+    for (uint8_t i = 0; i < this->rdsHandlerCount; i++)
+    {
+        if (rdsHandlers[i].aid == 0 || rdsHandlers[i].aid != group->blockD)
+            continue; // Fixed group handler or another application
+        changed |= rdsHandlers[i].group != code;
+        rdsHandlers[i].group = code;
+        rdsHandlers[i].handler(group, valid);
+    }
+    if (changed)
+        updateRdsHandlerGroups();
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Decodes a RadioText Plus group (the group type announced in the group 3A)
+ * @details Two tags per group: content type (6 bits), start (6 bits) and length - 1 (6 or 5 bits). A change of the item toggle bit
+ * @details means a new item: the previous tags are removed.
+ * @param group  group
+ * @param valid  valid block mask
+ */
+void SI470X::processRdsRtPlus(const si470x_rds_group *group, uint8_t valid)
+{
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    uint8_t toggle = (group->blockB >> 4) & 1;
+
+    if ((valid & (SI470X_RDS_BLOCK_C | SI470X_RDS_BLOCK_D)) != (SI470X_RDS_BLOCK_C | SI470X_RDS_BLOCK_D))
+        return;
+
+    if (toggle != this->rdsRtPlusToggle)
+    {
+        this->rdsRtPlusToggle = toggle;
+        this->rdsRtPlusCount = 0;
+    }
+    this->rdsRtPlusRunning = (group->blockB >> 3) & 1;
+    addRdsRtPlusTag(((group->blockB & 0x07) << 3) | (group->blockC >> 13), (group->blockC >> 7) & 0x3F, ((group->blockC >> 1) & 0x3F) + 1);
+    addRdsRtPlusTag(((group->blockC & 0x01) << 5) | (group->blockD >> 11), (group->blockD >> 5) & 0x3F, (group->blockD & 0x1F) + 1);
+#else
+    (void)group;
+    (void)valid;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Keeps a RadioText Plus tag (the tag of the same content type is replaced)
+ * @param type  content type (0 = dummy, ignored)
+ * @param start  position of the first character
+ * @param length  number of characters
+ */
+void SI470X::addRdsRtPlusTag(uint8_t type, uint8_t start, uint8_t length)
+{
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    uint8_t i;
+
+    if (type == 0 || (start + length) > 64)
+        return;
+    for (i = 0; i < this->rdsRtPlusCount && rdsRtPlus[i].type != type; i++)
+        ;
+    if (i == this->rdsRtPlusCount)
+    {
+        if (this->rdsRtPlusCount < SI470X_RDS_RTPLUS_SIZE)
+            this->rdsRtPlusCount++;
+        else
+            i--; // The oldest tag is replaced
+    }
+    memmove(&rdsRtPlus[1], &rdsRtPlus[0], i * sizeof(si470x_rds_rtplus_tag));
+    rdsRtPlus[0].type = type;
+    rdsRtPlus[0].start = start;
+    rdsRtPlus[0].length = length;
+#else
+    (void)type;
+    (void)start;
+    (void)length;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Gets a part of the RadioText described by a RadioText Plus tag (title, artist, ...)
+ * @details Nothing is copied: text points to the RadioText buffer (see getRdsProgramInformation) and the part is not terminated.
+ * @details It does not use the I2C bus. Please, check if getRdsReady (or processRdsGroup) was called before.
+ * @code
+ * const char *title;
+ * uint8_t length;
+ * if (rx.getRdsRtPlus(SI470X_RTPLUS_ITEM_TITLE, &title, &length))
+ *   Serial.write(title, length);
+ * @endcode
+ * @param type  content type (SI470X_RTPLUS_ITEM_TITLE, SI470X_RTPLUS_ITEM_ARTIST, ...)
+ * @param text  receives the first character of the part
+ * @param length  receives the number of characters
+ * @return false if there is no tag of this type or if the RadioText does not have the part (yet)
+ */
+bool SI470X::getRdsRtPlus(uint8_t type, const char **text, uint8_t *length)
+{
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    const char *buffer = (rds_buffer2A[0] != '\0') ? rds_buffer2A : rds_buffer2B;
+
+    for (uint8_t i = 0; i < this->rdsRtPlusCount; i++)
+    {
+        if (rdsRtPlus[i].type != type)
+            continue;
+        if ((rdsRtPlus[i].start + rdsRtPlus[i].length) > strlen(buffer))
+            return false;
+        *text = buffer + rdsRtPlus[i].start;
+        *length = rdsRtPlus[i].length;
+        return true;
+    }
+#else
+    (void)type;
+    (void)text;
+    (void)length;
+#endif
+    return false;
+}
+
+/**
+ * @ingroup GA04
+ * @brief Calls the application handlers of a group code
+ * @details A single bit test skips the groups without handlers.
+ * @param code  group code (SI470X_RDS_GROUP)
+ * @param group  group
+ * @param valid  valid block mask
+ */
+void SI470X::callRdsHandlers(uint8_t code, const si470x_rds_group *group, uint8_t valid)
+{
+#if SI470X_RDS_HANDLER_SIZE > 0
+    if (!(this->rdsHandlerGroups & (1UL << code)))
+        return;
+    for (uint8_t i = 0; i < this->rdsHandlerCount; i++)
+    {
+        if (rdsHandlers[i].group == code)
+            rdsHandlers[i].handler(group, valid);
+    }
+#else
+    (void)code;
+    (void)group;
+    (void)valid;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Rebuilds the mask of the group codes with handlers (rdsHandlerGroups)
+ */
+void SI470X::updateRdsHandlerGroups()
+{
+#if SI470X_RDS_HANDLER_SIZE > 0
+    this->rdsHandlerGroups = 0;
+    for (uint8_t i = 0; i < this->rdsHandlerCount; i++)
+    {
+        if (rdsHandlers[i].group != SI470X_RDS_NO_GROUP)
+            this->rdsHandlerGroups |= 1UL << rdsHandlers[i].group;
+    }
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Unbinds the ODA handlers from the groups announced by the previous station
+ * @details Each station chooses the groups of its applications. The handlers are bound again by the next group 3A.
+ */
+void SI470X::unbindRdsOda()
+{
+#if SI470X_RDS_HANDLER_SIZE > 0
+    for (uint8_t i = 0; i < this->rdsHandlerCount; i++)
+    {
+        if (rdsHandlers[i].aid != 0)
+            rdsHandlers[i].group = SI470X_RDS_NO_GROUP;
+    }
+    updateRdsHandlerGroups();
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Registers a function called with each group of a given type and version
+ * @details The handler is called after the library decoder of the group (if any), so the library buffers are already up to date.
+ * @details Use it to add decoders (for example, in-house data channels or EWS) without changing the library.
+ * @details See SI470X_RDS_HANDLER_SIZE for the number of handlers.
+ * @code
+ * void onGroup8A(const si470x_rds_group *group, uint8_t valid) {
+ *   if (valid & SI470X_RDS_BLOCK_C) { ... }
+ * }
+ *
+ * rx.addRdsGroupHandler(SI470X_RDS_GROUP(8, 0), onGroup8A);
+ * @endcode
+ * @param code  group code: SI470X_RDS_GROUP(type, version) with version 0 = A and 1 = B
+ * @param handler  function
+ * @return false if the registry is full (or not available) or the parameters are invalid
+ */
+bool SI470X::addRdsGroupHandler(uint8_t code, si470x_rds_handler handler)
+{
+#if SI470X_RDS_HANDLER_SIZE > 0
+    if (this->rdsHandlerCount >= SI470X_RDS_HANDLER_SIZE || handler == NULL || code > SI470X_RDS_GROUP(15, 1))
+        return false;
+    rdsHandlers[this->rdsHandlerCount].aid = 0;
+    rdsHandlers[this->rdsHandlerCount].group = code;
+    rdsHandlers[this->rdsHandlerCount].handler = handler;
+    this->rdsHandlerCount++;
+    this->rdsHandlerGroups |= 1UL << code;
+    return true;
+#else
+    (void)code;
+    (void)handler;
+    return false;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Registers a function called with the groups of an Open Data Application (ODA)
+ * @details The station announces in the group 3A which group type carries the application (AID). From then on, the handler
+ * @details receives these groups and the groups 3A of the application (block C: application message). Check the group type
+ * @details in the block B to tell them apart. The binding is reset on each tune or seek (see getRdsOdaGroup).
+ * @code
+ * #define AID_TMC 0xCD46
+ *
+ * rx.addRdsOdaHandler(AID_TMC, onTmc);
+ * @endcode
+ * @param aid  Application Identification (not 0)
+ * @param handler  function
+ * @return false if the registry is full (or not available) or the parameters are invalid
+ */
+bool SI470X::addRdsOdaHandler(uint16_t aid, si470x_rds_handler handler)
+{
+#if SI470X_RDS_HANDLER_SIZE > 0
+    if (this->rdsHandlerCount >= SI470X_RDS_HANDLER_SIZE || handler == NULL || aid == 0)
+        return false;
+    rdsHandlers[this->rdsHandlerCount].aid = aid;
+    rdsHandlers[this->rdsHandlerCount].group = SI470X_RDS_NO_GROUP;
+    rdsHandlers[this->rdsHandlerCount].handler = handler;
+    this->rdsHandlerCount++;
+    return true;
+#else
+    (void)aid;
+    (void)handler;
+    return false;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Removes all the registrations of a handler (see addRdsGroupHandler and addRdsOdaHandler)
+ * @param handler  function
+ */
+void SI470X::removeRdsHandler(si470x_rds_handler handler)
+{
+#if SI470X_RDS_HANDLER_SIZE > 0
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < this->rdsHandlerCount; i++)
+    {
+        if (rdsHandlers[i].handler != handler)
+            rdsHandlers[count++] = rdsHandlers[i];
+    }
+    this->rdsHandlerCount = count;
+    updateRdsHandlerGroups();
+#else
+    (void)handler;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Gets the group that carries an Open Data Application on the tuned station
+ * @details Known for the RadioText Plus and for the applications registered by addRdsOdaHandler, after their group 3A.
+ * @param aid  Application Identification
+ * @return group code (SI470X_RDS_GROUP) or SI470X_RDS_NO_GROUP if it was not announced
+ */
+uint8_t SI470X::getRdsOdaGroup(uint16_t aid)
+{
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    if (aid == SI470X_RDS_AID_RTPLUS)
+        return this->rdsRtPlusGroup;
+#endif
+#if SI470X_RDS_HANDLER_SIZE > 0
+    for (uint8_t i = 0; i < this->rdsHandlerCount; i++)
+    {
+        if (rdsHandlers[i].aid == aid)
+            return rdsHandlers[i].group;
+    }
+#endif
+    (void)aid;
+    return SI470X_RDS_NO_GROUP;
+}
+
+/**
+ * @ingroup GA04
+ * @brief Decodes the group 10A (Program Type Name)
+ * @details Two segments of 4 characters (blocks C and D). A change of the A/B flag starts a new name.
+ * @param group  group
+ * @param valid  valid block mask
+ */
+void SI470X::processRdsGroup10A(const si470x_rds_group *group, uint8_t valid)
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PTYN)
+    uint8_t flagAB = (group->blockB >> 4) & 1;
+    uint8_t segment = group->blockB & 1;
+    char *c = &rdsPtynWork[segment * 4];
+
+    if ((valid & (SI470X_RDS_BLOCK_C | SI470X_RDS_BLOCK_D)) != (SI470X_RDS_BLOCK_C | SI470X_RDS_BLOCK_D))
+        return;
+
+    if (flagAB != this->rdsPtynFlagAB)
+    {
+        this->rdsPtynFlagAB = flagAB;
+        this->rdsPtynReady = 0;
+    }
+    c[0] = group->blockC >> 8;
+    c[1] = group->blockC & 0xFF;
+    c[2] = group->blockD >> 8;
+    c[3] = group->blockD & 0xFF;
+    this->rdsPtynReady |= 1 << segment;
+
+    if (this->rdsPtynReady == 0x03)
+    {
+        memcpy(rdsPtyn, rdsPtynWork, sizeof(rdsPtynWork));
+        rdsPtyn[8] = '\0';
+        this->rdsPtynReady = 0;
+    }
+#else
+    (void)group;
+    (void)valid;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Decodes the groups 14A and 14B (Enhanced Other Networks)
+ * @details Keeps the PI code, the frequency (AF or mapped frequency of the tuned frequency) and the TP/TA flags of the other networks.
+ * @details In traffic mode (see setRdsTrafficMode), a traffic announcement of an other network with a known frequency switches the receiver to it.
+ * @param group  group
+ * @param valid  valid block mask
+ */
+void SI470X::processRdsGroup14(const si470x_rds_group *group, uint8_t valid)
+{
+#if SI470X_RDS_EON_SIZE > 0
+    si470x_rds_eon eon;
+    uint8_t i, code1, code2, tuned;
+    bool ta;
+
+    if (!(valid & SI470X_RDS_BLOCK_D) || group->blockD == 0 || group->blockD == this->rdsPi)
+        return; // Block D: PI code of the other network
+
+    for (i = 0; i < this->rdsEonCount && rdsEon[i].pi != group->blockD; i++)
+        ;
+    if (i < this->rdsEonCount)
+        eon = rdsEon[i];
+    else
+    {
+        memset(&eon, 0, sizeof(eon));
+        eon.pi = group->blockD;
+        if (this->rdsEonCount < SI470X_RDS_EON_SIZE)
+            this->rdsEonCount++;
+        else
+            i--; // The least recently referenced one is replaced
+    }
+
+    eon.tp = (group->blockB >> 4) & 1;
+    ta = eon.ta;
+    if (group->blockB & 0x0800)
+        ta = (group->blockB >> 3) & 1; // 14B: TA of the other network
+    else if (valid & SI470X_RDS_BLOCK_C)
+    {
+        code1 = group->blockC >> 8;
+        code2 = group->blockC & 0xFF;
+        tuned = (this->currentFrequency > 8750 && this->currentFrequency <= 10790) ? (this->currentFrequency - 8750) / 10 : 0;
+        switch (group->blockB & 0x0F)
+        {
+        case 4: // AF (method A). The first frequency is kept if there is no mapped frequency.
+            if (!eon.mapped && eon.af == 0)
+                eon.af = (code1 >= 1 && code1 <= 204) ? code1 : ((code2 >= 1 && code2 <= 204) ? code2 : 0);
+            break;
+        case 5:
+        case 6:
+        case 7:
+        case 8:
+        case 9: // Mapped frequencies: tuned frequency and frequency of the other network
+            if (code1 == tuned && code2 >= 1 && code2 <= 204)
+            {
+                eon.af = code2;
+                eon.mapped = 1;
+            }
+            break;
+        case 13: // PTY and TA of the other network
+            ta = group->blockC & 1;
+            break;
+        }
+    }
+
+    // Most recently referenced first
+    memmove(&rdsEon[1], &rdsEon[0], i * sizeof(si470x_rds_eon));
+    rdsEon[0] = eon;
+    if (ta == eon.ta)
+        return;
+    rdsEon[0].ta = ta;
+
+#if SI470X_RDS_TRAFFIC
+    if (ta && eon.tp && eon.af != 0 && this->trafficMode && this->trafficEon && this->trafficReturnFrequency == 0 &&
+        !this->rdsTrafficAnnouncement && this->tuneState == SI470X_TUNE_IDLE && this->pendingChannel == SI470X_NO_CHANNEL &&
+        !isRdsAfSearching())
+    {
+        // The switch is done by poll(): the RDS decoder does not tune (it may be running over the RDS FIFO)
+        this->pendingChannel = frequencyToChannel(8750 + eon.af * 10);
+        this->pendingRetune = SI470X_RETUNE_TRAFFIC;
+        this->trafficReturnFrequency = this->currentFrequency;
+        this->trafficSwitchTime = millis();
+        this->trafficConfirmed = false;
+        updateTrafficAnnouncement(true);
+    }
+#endif
+#else
+    (void)group;
+    (void)valid;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Starts or finishes a traffic announcement
+ * @details In traffic mode, the volume is raised and the audio unmuted during the announcement. At the end, the receiver
+ * @details goes back to the original station if it had switched to an EON traffic station. The return tune is started by poll().
+ * @param active  true = the announcement starts
+ */
+void SI470X::updateTrafficAnnouncement(bool active)
+{
+#if SI470X_RDS_TRAFFIC
+    uint16_t frequency = this->trafficReturnFrequency;
+
+    this->rdsTrafficAnnouncement = active;
+    if (this->trafficMode && active != this->trafficAudio)
+    {
+        if (active)
+        {
+            this->trafficDmute = reg02->refined.DMUTE;
+            reg02->refined.DMUTE = 1;
+            if (this->trafficVolume > this->currentVolume)
+                reg05->refined.VOLUME = this->trafficVolume;
+        }
+        else
+        {
+            reg02->refined.DMUTE = this->trafficDmute;
+            reg05->refined.VOLUME = this->currentVolume;
+        }
+        this->trafficAudio = active;
+        if (active || frequency == 0)
+            setAllRegisters(); // Otherwise, the registers are written with the return tune
+    }
+
+    if (this->trafficAnnouncementHandler != NULL)
+        this->trafficAnnouncementHandler(active);
+
+    if (!active && frequency != 0)
+    {
+        this->trafficReturnFrequency = 0;
+        if (this->pendingChannel != SI470X_NO_CHANNEL && this->pendingRetune == SI470X_RETUNE_TRAFFIC)
+            this->pendingChannel = SI470X_NO_CHANNEL; // The switch has not started: still on the original station
+        else if (this->pendingChannel == SI470X_NO_CHANNEL && this->pendingSeek == SI470X_NO_SEEK) // Otherwise, the application has already tuned another station
+        {
+            this->pendingChannel = frequencyToChannel(frequency);
+            this->pendingRetune = SI470X_RETUNE_TRAFFIC;
+        }
+    }
+#else
+    (void)active;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Sets the traffic mode
+ * @details During a traffic announcement of the tuned station (TP = 1 and TA = 1), the audio is unmuted and the volume raised.
+ * @details If eon is true, a traffic announcement of an other network linked by EON (groups 14A/14B) switches the receiver
+ * @details to that station. The receiver comes back when the announcement finishes (or after SI470X_TRAFFIC_TIMEOUT ms
+ * @details if the other station does not confirm it). The RDS decoder (processRdsGroup or getRdsReady) requests the switches and poll() tunes.
+ * @details Turning the mode off finishes the announcement in progress (onTrafficAnnouncement receives false) and poll() tunes back.
+ * @code
+ * rx.setRdsTrafficMode(true, 12);
+ * rx.onTrafficAnnouncement(showTrafficIcon);
+ * .
+ * .
+ * void loop() {
+ *   rx.getRdsReady();
+ *   rx.poll();
+ * }
+ * @endcode
+ * @see onTrafficAnnouncement, isRdsTrafficSwitched, getRdsEon
+ * @param value  true = traffic mode on
+ * @param volume  volume of the announcements (0 to 15). The current volume is kept if it is higher.
+ * @param eon  true = follow the traffic announcements of other networks
+ */
+void SI470X::setRdsTrafficMode(bool value, uint8_t volume, bool eon)
+{
+#if SI470X_RDS_TRAFFIC
+    if (!value && (this->rdsTrafficAnnouncement || this->trafficReturnFrequency != 0))
+        updateTrafficAnnouncement(false); // Restores the audio and requests the return tune
+    this->trafficMode = value;
+    this->trafficVolume = (volume > 15) ? 15 : volume;
+    this->trafficEon = eon;
+#else
+    (void)value;
+    (void)volume;
+    (void)eon;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Saves the RDS data of the current station in the RDS cache
+ * @details Called when the station changes (tune, seek and clearRdsBuffer). The next valid block A is looked up in the cache.
+ * @details Only the name, the text and the AF list sent by the station with the confirmed PI code are saved (see rdsPsPi and rdsRtPi).
+ * @details The content already cached for the station is kept for the fields it did not send this time.
+ */
+void SI470X::storeRdsCache()
+{
+#if SI470X_RDS_CACHE_SIZE > 0
+    uint8_t i;
+    si470x_rds_cache_entry e;
+    bool ps = this->rdsPsPi == this->rdsPi && rds_buffer0A[0] != '\0';
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    bool rt = this->rdsRtPi == this->rdsPi && (rds_buffer2A[0] != '\0' || rds_buffer2B[0] != '\0');
+#else
+    bool rt = false;
+#endif
+
+    this->rdsCacheLookup = true;
+    if (this->rdsPi == 0 || (!ps && !rt))
+        return;
+
+    // The same station or the least recently used one (the last) is replaced
+    for (i = 0; i < (SI470X_RDS_CACHE_SIZE - 1) && rdsCache[i].pi != this->rdsPi; i++)
+        ;
+    if (rdsCache[i].pi == this->rdsPi)
+        e = rdsCache[i];
+    else
+        memset(&e, 0, sizeof(e));
+    memmove(&rdsCache[1], &rdsCache[0], i * sizeof(si470x_rds_cache_entry));
+
+    e.pi = this->rdsPi;
+    e.pty = this->rdsPty;
+    if (ps)
+        memcpy(e.ps, rds_buffer0A, sizeof(e.ps));
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    if (rt)
+    {
+        e.rt2B = (rds_buffer2A[0] == '\0');
+        if (e.rt2B)
+            memcpy(e.rt, rds_buffer2B, sizeof(rds_buffer2B));
+        else
+            memcpy(e.rt, rds_buffer2A, sizeof(e.rt));
+    }
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    if (this->rdsAfPi == this->rdsPi)
+    {
+        e.afCount = this->rdsAfCount;
+        memcpy(e.af, rdsAf, this->rdsAfCount);
+    }
+#endif
+    rdsCache[0] = e;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Publishes the RDS data kept in the RDS cache for a given PI code
+ * @details The station name and the radio text are shown at once. They are replaced as soon as different content is received.
+ * @param pi  PI code of the first valid block A of the station
+ */
+void SI470X::loadRdsCache(uint16_t pi)
+{
+#if SI470X_RDS_CACHE_SIZE > 0
+    uint8_t i;
+    si470x_rds_cache_entry e;
+
+    for (i = 0; i < SI470X_RDS_CACHE_SIZE && rdsCache[i].pi != pi; i++)
+        ;
+    if (pi == 0 || i == SI470X_RDS_CACHE_SIZE)
+        return;
+
+    // Most recently used first
+    e = rdsCache[i];
+    memmove(&rdsCache[1], &rdsCache[0], i * sizeof(si470x_rds_cache_entry));
+    rdsCache[0] = e;
+
+    if (e.ps[0] != '\0' && memcmp(rds_buffer0A, e.ps, sizeof(e.ps)) != 0)
+    {
+        memcpy(rds_buffer0A, e.ps, sizeof(e.ps));
+        rds_buffer0A[8] = '\0';
+        this->rdsPsVersion++;
+#if SI470X_RDS_CALLBACKS && SI470X_RDS_HAS(SI470X_RDS_DECODE_PS)
+        if (this->programServiceHandler != NULL)
+            this->programServiceHandler(rds_buffer0A);
+#endif
+    }
+    if (e.ps[0] != '\0')
+        this->rdsPsPi = pi;
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    char *buffer = (e.rt2B) ? rds_buffer2B : rds_buffer2A;
+    uint8_t size = (e.rt2B) ? (sizeof(rds_buffer2B) - 1) : sizeof(e.rt);
+    if (e.rt[0] != '\0' && strncmp(buffer, e.rt, size) != 0)
+    {
+        memcpy(buffer, e.rt, size);
+        buffer[size] = '\0';
+        this->rdsRtVersion++;
+#if SI470X_RDS_CALLBACKS
+        if (this->radioTextHandler != NULL)
+            this->radioTextHandler(buffer);
+#endif
+    }
+    if (e.rt[0] != '\0')
+        this->rdsRtPi = pi;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    if (this->rdsAfPi != pi)
+    {
+        this->rdsAfPi = pi;
+        this->rdsAfCount = e.afCount;
+        this->afFailed = 0;
+        memcpy(rdsAf, e.af, e.afCount);
+    }
+#endif
+    if (e.pty != 0xFF && e.pty != this->rdsPty)
+    {
+        this->rdsPty = e.pty;
+#if SI470X_RDS_CALLBACKS
+        if (this->ptyHandler != NULL)
+            this->ptyHandler(this->rdsPty);
+#endif
+    }
+#else
+    (void)pi;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Removes all stations from the RDS cache
+ * @details The RDS cache keeps the station name, the last radio text, the program type and the AF list of the latest SI470X_RDS_CACHE_SIZE stations
+ * @details (by PI code). When you tune a station again, they are shown as soon as the first group is received instead of waiting
+ * @details for the complete name and text (seconds).
+ */
+void SI470X::clearRdsCache()
+{
+#if SI470X_RDS_CACHE_SIZE > 0
+    memset(rdsCache, 0, sizeof(rdsCache));
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Decodes the groups 1A and 1B (Program Item Number and slow labelling codes)
+ * @details Block C of the group 1A: variant 0 carries the Extended Country Code; variant 3 carries the language code.
+ * @details Block D: Program Item Number (day, hour and minute of the scheduled start of the program).
+ * @param group  group
+ * @param valid  valid block mask
+ */
+void SI470X::processRdsGroup1(const si470x_rds_group *group, uint8_t valid)
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PIN)
+    if (!(group->blockB & 0x0800) && (valid & SI470X_RDS_BLOCK_C))
+    {
+        switch ((group->blockC >> 12) & 0x07)
+        {
+        case 0:
+            this->rdsEcc = group->blockC & 0xFF;
+            break;
+        case 3:
+            this->rdsLanguage = group->blockC & 0xFF;
+            break;
+        }
+    }
+
+    // PIN: day (5 bits), hour (5 bits) and minute (6 bits). Day 0 means no valid PIN.
+    if ((valid & SI470X_RDS_BLOCK_D) && ((group->blockD >> 6) & 0x1F) <= 23 && (group->blockD & 0x3F) <= 59)
+        this->rdsPin = group->blockD;
+#else
+    (void)group;
+    (void)valid;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Gets the Program Item Number (PIN) of the current program
+ * @details The PIN is the scheduled start of the program: day of the month, hour and minute (local time).
+ * @param day     day of the month (1-31)
+ * @param hour    hour (0-23)
+ * @param minute  minute (0-59)
+ * @return false if no PIN was received
+ */
+bool SI470X::getRdsProgramItemNumber(uint8_t *day, uint8_t *hour, uint8_t *minute)
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PIN)
+    if ((this->rdsPin >> 11) == 0)
+        return false;
+
+    *day = this->rdsPin >> 11;
+    *hour = (this->rdsPin >> 6) & 0x1F;
+    *minute = this->rdsPin & 0x3F;
+    return true;
+#else
+    (void)day;
+    (void)hour;
+    (void)minute;
+    return false;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Gets the RDS Text when the message is of the Group Type 2 version A
+ * @details Same as getRdsText2A.
+ * @return char*  The string (char array) with the content (Text) received from group 2A 
+ */
+char *SI470X::getRdsText(void)
+{
+    return getRdsText2A();
+}
+
+/**
+ * @ingroup GA04
+ * @todo RDS Dynamic PS or Scrolling PS support
+ * @details It does not use the I2C bus. Please, check if getRdsReady (or processRdsGroup) was called before.
+ * @brief Gets the station name and other messages. 
+ * @details Only complete names are returned: the name changes when all segments of the new one were received. See getRdsStationNameVersion.
+ * @return char* should return a string with the station name (NULL if nothing was received). 
+ *         However, some stations send other kind of messages
+ */
+char *SI470X::getRdsText0A(void)
+{
+    return (rds_buffer0A[0] != '\0') ? rds_buffer0A : NULL;
+}
+
+/**
+ * @ingroup @ingroup GA04
+ * 
+ * @brief Gets the Text processed for the 2A group
+ * @details It does not use the I2C bus. Please, check if getRdsReady (or processRdsGroup) was called before.
+ * @return char* string with the Text of the group A2 (NULL if nothing was received)
+ */
+char *SI470X::getRdsText2A(void)
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    return (rds_buffer2A[0] != '\0') ? rds_buffer2A : NULL;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Gets the Text processed for the 2B group
+ * @details It does not use the I2C bus. Please, check if getRdsReady (or processRdsGroup) was called before.
+ * @return char* string with the Text of the group AB (NULL if nothing was received)
+ */
+char *SI470X::getRdsText2B(void)
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    return (rds_buffer2B[0] != '\0') ? rds_buffer2B : NULL;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @ingroup GA04 
+ * @brief Gets the RDS clock time and date (group 4A) as numbers
+ * @details It does not use the I2C bus and does not format strings. The date is converted from the Modified Julian Day with integer arithmetic only.
+ * @details The local time is the UTC time plus the local offset. The date changes if it crosses midnight.
+ * @details The group 4A is sent once a minute. Use getRdsClockTimeVersion to check if there is a new one.
+ * @code
+ * si470x_rds_clock_time ct;
+ * if (rx.getRdsClockTimeVersion() != shownVersion && rx.getRdsClockTime(&ct, true)) {
+ *   shownVersion = rx.getRdsClockTimeVersion();
+ *   showClock(ct.hour, ct.minute);
+ * }
+ * @endcode
+ * @see getRdsTime, getRdsLocalTime, getRdsLocalDateTime
+ * @param ct         receives the date and time
+ * @param localTime  true = local time; false = UTC
+ * @return false if no valid group 4A was received
+ */
+bool SI470X::getRdsClockTime(si470x_rds_clock_time *ct, bool localTime)
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
+    int16_t minutes;
+    uint32_t mjd;
+
+    if (this->rdsClockVersion == 0)
+        return false;
+
+    mjd = this->rdsClockMjd;
+    minutes = this->rdsClockMinutes;
+    if (localTime)
+        minutes += this->rdsClockOffset * 30;
+    if (minutes < 0)
+    {
+        minutes += 1440;
+        mjd--;
+    }
+    else if (minutes >= 1440)
+    {
+        minutes -= 1440;
+        mjd++;
+    }
+
+    // EN 50067, Annex G (scaled to integers)
+    uint32_t y = (mjd * 100 - 1507820) / 36525;
+    uint32_t yd = y * 36525 / 100;
+    uint32_t m = ((mjd - 14956 - yd) * 10000 - 1000) / 306001;
+    uint8_t k = (m == 14 || m == 15) ? 1 : 0;
+
+    ct->day = mjd - 14956 - yd - m * 306001 / 10000;
+    ct->month = m - 1 - k * 12;
+    ct->year = 1900 + y + k;
+    ct->hour = minutes / 60;
+    ct->minute = minutes % 60;
+    ct->offset = localTime ? 0 : this->rdsClockOffset;
+    return true;
+#else
+    (void)ct;
+    (void)localTime;
+    return false;
+#endif
+}
+
+/**
+ * @ingroup GA04 
+ * @brief Gets the RDS time and date when the Group type is 4 
+ * @details It does not use the I2C bus. It formats the latest group 4A received (see processRdsGroup and getRdsClockTime).
+ * @return char* a string with hh:mm +/- offset (UTC time) or NULL if no time was received
+ */
+char *SI470X::getRdsTime()
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
+    si470x_rds_clock_time ct;
+    uint8_t offset;
+
+    if (!getRdsClockTime(&ct, false))
+        return NULL;
+
+    offset = (ct.offset < 0) ? -ct.offset : ct.offset;
+    this->convertToChar(ct.hour, rds_time, 2, 0, ' ', false);
+    rds_time[2] = ':';
+    this->convertToChar(ct.minute, &rds_time[3], 2, 0, ' ', false);
+    rds_time[5] = ' ';
+    rds_time[6] = (ct.offset < 0) ? '-' : '+';
+    this->convertToChar(offset / 2, &rds_time[7], 2, 0, ' ', false);
+    rds_time[9] = ':';
+    this->convertToChar((offset & 1) * 30, &rds_time[10], 2, 0, ' ', false);
+    rds_time[12] = '\0';
+
+    return rds_time;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Gets the RDS time converted to local time.
+ * @details It does not use the I2C bus. It formats the latest group 4A received (see processRdsGroup and getRdsClockTime).
+ * @details ATTENTION: Some stations broadcast wrong time.
+ * @return char* a string with hh:mm (NULL if no time was received)
+ * @see getRdsReady, processRdsGroup
+ */
+char *SI470X::getRdsLocalTime()
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
+    si470x_rds_clock_time ct;
+
+    if (!getRdsClockTime(&ct, true))
+        return NULL;
+
+    this->convertToChar(ct.hour, rds_time, 2, 0, ' ', false);
+    rds_time[2] = ':';
+    this->convertToChar(ct.minute, &rds_time[3], 2, 0, ' ', false);
+    rds_time[5] = '\0';
+
+    return rds_time;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @ingroup GA04
+ * @brief Gets the RDS date and time converted to local time.
+ * @details It does not use the I2C bus. It formats the latest group 4A received (see processRdsGroup and getRdsClockTime).
+ * @return char* a string with YYYY-MM-DD hh:mm (NULL if no time was received)
+ */
+char *SI470X::getRdsLocalDateTime()
+{
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
+    si470x_rds_clock_time ct;
+
+    if (!getRdsClockTime(&ct, true))
+        return NULL;
+
+    this->convertToChar(ct.year, rds_time, 4, 0, ' ', false);
+    rds_time[4] = '-';
+    this->convertToChar(ct.month, &rds_time[5], 2, 0, ' ', false);
+    rds_time[7] = '-';
+    this->convertToChar(ct.day, &rds_time[8], 2, 0, ' ', false);
+    rds_time[10] = ' ';
+    this->convertToChar(ct.hour, &rds_time[11], 2, 0, ' ', false);
+    rds_time[13] = ':';
+    this->convertToChar(ct.minute, &rds_time[14], 2, 0, ' ', false);
+    rds_time[16] = '\0';
+
+    return rds_time;
+#else
     return NULL;
+#endif
 }
 
 
@@ -1147,7 +3381,7 @@ bool SI470X::getRdsAllData(char **stationName, char **stationInformation, char *
     *programInformation = this->getRdsText2A(); // returns NULL if no information
     *utcTime = this->getRdsTime();              // returns NULL if no information
 
-    return (bool)stationName | (bool)stationInformation | (bool)programInformation | (bool)utcTime;
+    return *stationName != NULL || *stationInformation != NULL || *programInformation != NULL || *utcTime != NULL;
 }
 
 
@@ -1155,13 +3389,64 @@ bool SI470X::getRdsAllData(char **stationName, char **stationInformation, char *
  * @ingroup GA04
  * @brief Clear RDS Information (Station Name, Station Information, Program Information and Time)
  * @details Clear the buffer with latest RDS information
+ * @details The information of the current station is kept in the RDS cache (see clearRdsCache).
  */
 void SI470X::clearRdsBuffer()
 {
+    storeRdsCache();
     memset(rds_buffer0A, 0, sizeof(rds_buffer0A));
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PS)
+    memset(rdsPsWork, 0, sizeof(rdsPsWork));
+    this->rdsPsReady = 0;
+#endif
+    this->rdsPsVersion++;
+    this->rdsPsPi = 0;
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
     memset(rds_buffer2A, 0, sizeof(rds_buffer2A));
     memset(rds_buffer2B, 0, sizeof(rds_buffer2B));
+#if SI470X_RDS_RT_WORK
+    memset(rdsRtWork, ' ', sizeof(rdsRtWork));
+#endif
+    this->rdsRtSegments = 0;
+    this->rdsRtEnd = 64;
+    this->rdsRtFlagAB = 0xFF;
+    this->rdsRtVersion++;
+    this->rdsRtPi = 0;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
     memset(rds_time, 0, sizeof(rds_time));
+    this->rdsClockVersion = 0;
+#endif
+    this->rdsPty = 0xFF;
+#if SI470X_RDS_TRAFFIC
+    this->rdsTrafficAnnouncement = false;
+#endif
+    this->rdsPi = this->rdsPiCandidate = 0;
+    this->rdsPiCount = 0;
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PIN)
+    this->rdsEcc = this->rdsLanguage = 0;
+    this->rdsPin = 0;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    this->rdsAfCount = 0;
+    this->rdsAfPi = 0;
+    this->rdsAfMethodB = false;
+    this->afFailed = 0;
+#endif
+#if SI470X_RDS_EON_SIZE > 0
+    this->rdsEonCount = 0;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PTYN)
+    memset(rdsPtyn, 0, sizeof(rdsPtyn));
+    this->rdsPtynReady = 0;
+    this->rdsPtynFlagAB = 0xFF;
+#endif
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    this->rdsRtPlusCount = 0;
+    this->rdsRtPlusGroup = this->rdsRtPlusToggle = 0xFF;
+    this->rdsRtPlusRunning = false;
+#endif
+    unbindRdsOda();
 }
 
 
@@ -1207,13 +3492,12 @@ void SI470X::adjustRdsText(char *text, int size) {
  */
 int SI470X::checkI2C(uint8_t *addressArray)
 {
-    Wire.begin();
+    this->bus->begin();
     int error, address;
     int idx = 0;
     for (address = 1; address < 127; address++)
     {
-        Wire.beginTransmission(address);
-        error = Wire.endTransmission();
+        error = this->bus->probe(address);
         if (error == 0)
         {
             addressArray[idx] = address;
@@ -1222,7 +3506,7 @@ int SI470X::checkI2C(uint8_t *addressArray)
         else if (error == 4)
             return -1;
     }
-    Wire.end();
+    this->bus->end();
     delay(200);
     return idx;
 }
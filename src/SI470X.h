@@ -10,8 +10,15 @@
  * Contact: pu2clr@gmail.com
  */
 
+#ifndef SI470X_H
+#define SI470X_H
+
+#if defined(ARDUINO)
 #include <Arduino.h>
 #include <Wire.h>
+#else
+#include "SI470XHost.h" // Host build (Linux, macOS). See SI470XSim.h
+#endif
 
 #define MAX_DELAY_AFTER_OSCILLATOR 500 // Max delay after the crystal oscilator becomes active
 
@@ -26,6 +33,350 @@
 #define SI470X_SEEK_WRAP 0 //
 #define SI470X_SEEK_STOP 1
 
+/**
+ * Configuration macros (SI470X_RDS_DECODERS, SI470X_RDS_*_SIZE, SI470X_*_STATS, SI470X_RDS_CALLBACKS, SI470X_RDS_TRAFFIC, SI470X_READ_WAIT, ...).
+ * Most of them change the members of the SI470X class, so the sketch and SI470X.cpp must see the same values. Define them only as
+ * global build flags: build_flags = -DSI470X_RDS_DECODERS=0x15 on PlatformIO, or
+ * --build-property "compiler.cpp.extra_flags=-DSI470X_RDS_DECODERS=0x15" on arduino-cli. In the Arduino IDE, change the default in this file.
+ * A #define placed before #include <SI470X.h> in the sketch does NOT reach the library: SI470X::setup detects the different class size and does nothing.
+ */
+
+/**
+ * Strategies to wait for the bytes after Wire.requestFrom (see SI470XWireBus::read).
+ * Define SI470X_READ_WAIT (for example, build_flags = -DSI470X_READ_WAIT=2 on PlatformIO) to override the platform default.
+ */
+#define SI470X_READ_WAIT_FIXED 0 //!< Waits a fixed time (SI470X_READ_DELAY). It is the only strategy that works on ATtiny cores.
+#define SI470X_READ_WAIT_NONE 1  //!< No wait. requestFrom only returns after receiving all bytes (AVR, ESP32, ESP8266, STM32, SAMD, RP2040).
+#define SI470X_READ_WAIT_POLL 2  //!< Polls Wire.available() up to SI470X_READ_TIMEOUT microseconds.
+
+#if defined(__AVR_ATtiny84__) || defined(__AVR_ATtiny85__) || defined(__AVR_ATtiny84A__) || defined(ATTINY_CORE)
+#define SI470X_ATTINY //!< Small ATtiny cores: TinyWireM based Wire and very little RAM
+#endif
+
+#ifndef SI470X_READ_WAIT
+#if defined(SI470X_ATTINY)
+#define SI470X_READ_WAIT SI470X_READ_WAIT_FIXED
+#elif defined(ARDUINO_ARCH_AVR) || defined(ESP32) || defined(ESP8266) || defined(ARDUINO_ARCH_STM32) || defined(ARDUINO_ARCH_SAMD) || defined(ARDUINO_ARCH_RP2040)
+#define SI470X_READ_WAIT SI470X_READ_WAIT_NONE
+#else
+#define SI470X_READ_WAIT SI470X_READ_WAIT_POLL
+#endif
+#endif
+
+#define SI470X_READ_DELAY 300    //!< Fixed wait after requestFrom in microseconds (SI470X_READ_WAIT_FIXED)
+#define SI470X_READ_TIMEOUT 2000 //!< Max wait for the bytes in microseconds (SI470X_READ_WAIT_POLL)
+
+#define SI470X_TUNE_IDLE 0       //!< No tune or seek in progress
+#define SI470X_TUNE_WAIT_STC 1   //!< TUNE or SEEK set. Waiting for STC = 1
+#define SI470X_TUNE_WAIT_CLEAR 2 //!< TUNE and SEEK cleared. Waiting for STC = 0
+
+#define SI470X_TUNE_TIME 60     //!< Typical tune time in ms. poll() does not read the status before it.
+#define SI470X_POLL_INTERVAL 5  //!< Minimum interval in ms between two status reads done by poll().
+#define SI470X_NO_CHANNEL 0xFFFF //!< No channel pending
+#define SI470X_NO_SEEK 0xFF      //!< No seek pending
+
+#define SI470X_RETUNE_USER 0 //!< Tune or seek requested by the application: a new station
+#define SI470X_RETUNE_AF 1   //!< Alternative Frequency of the same station (AF follow mode): the RDS data is kept
+#define SI470X_RETUNE_TRAFFIC 2 //!< Switch to an EON traffic station or back (traffic mode): a new station, the traffic state is kept
+#define SI470X_INTERRUPT_POLL_INTERVAL 100 //!< With the STC interrupt, interval in ms between status reads while no pulse arrives (seek progress and missed pulses)
+
+#if defined(ESP32) || defined(ESP8266)
+#define SI470X_ISR_ATTR IRAM_ATTR //!< Interrupt handlers must be in RAM on ESP32 and ESP8266
+#else
+#define SI470X_ISR_ATTR
+#endif
+
+#define SI470X_SEEK_EVENT_PROGRESS 0  //!< Seek moved to a new channel (READCHAN)
+#define SI470X_SEEK_EVENT_FOUND 1     //!< Seek found a valid station
+#define SI470X_SEEK_EVENT_FAILED 2    //!< Seek failed or reached the band limit (SF/BL)
+#define SI470X_SEEK_EVENT_CANCELLED 3 //!< Seek aborted by cancelSeek or by a new tune or seek
+
+/**
+ * Number of RDS groups kept by the RDS FIFO (see SI470X::rdsCapture). It must be a power of two (up to 128).
+ * Each group takes 9 bytes of RAM. Define SI470X_RDS_FIFO_SIZE to override the platform default.
+ */
+#ifndef SI470X_RDS_FIFO_SIZE
+#if defined(SI470X_ATTINY) || defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_FIFO_SIZE 1
+#else
+#define SI470X_RDS_FIFO_SIZE 32
+#endif
+#endif
+
+#if (SI470X_RDS_FIFO_SIZE & (SI470X_RDS_FIFO_SIZE - 1)) != 0 || SI470X_RDS_FIFO_SIZE > 128
+#error "SI470X_RDS_FIFO_SIZE must be a power of two up to 128"
+#endif
+
+/**
+ * RDS decoders compiled in (SI470X_RDS_DECODERS). The code and the buffers of the decoders left out are removed; their query
+ * functions return NULL, false or 0. For example, -DSI470X_RDS_DECODERS=SI470X_RDS_DECODE_PS keeps only the station name.
+ * The TA flag, the PTY and the PI code are always decoded. AF and EON are left out by default on AVR and ATtiny.
+ * See examples/size_report.sh for the flash and RAM of each configuration.
+ */
+#define SI470X_RDS_DECODE_PS 0x01   //!< Groups 0A/0B: station name
+#define SI470X_RDS_DECODE_PIN 0x02  //!< Groups 1A/1B: Extended Country Code, language and Program Item Number
+#define SI470X_RDS_DECODE_RT 0x04   //!< Groups 2A/2B: radio text (removes 98 bytes of RAM + the work buffer)
+#define SI470X_RDS_DECODE_ODA 0x08  //!< Group 3A: Open Data Applications (RadioText Plus and addRdsOdaHandler)
+#define SI470X_RDS_DECODE_CT 0x10   //!< Group 4A: clock time and the time formatters (removes 27 bytes of RAM)
+#define SI470X_RDS_DECODE_PTYN 0x20 //!< Group 10A: Program Type Name (removes 17 bytes of RAM)
+#define SI470X_RDS_DECODE_EON 0x40  //!< Groups 14A/14B: Enhanced Other Networks
+#define SI470X_RDS_DECODE_AF 0x80   //!< Alternative Frequencies (group 0A) and the AF follow mode
+#define SI470X_RDS_DECODE_ALL 0xFF
+
+#ifndef SI470X_RDS_DECODERS
+#if defined(SI470X_ATTINY)
+#define SI470X_RDS_DECODERS (SI470X_RDS_DECODE_PS | SI470X_RDS_DECODE_RT | SI470X_RDS_DECODE_CT)
+#elif defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_DECODERS (SI470X_RDS_DECODE_ALL & ~(SI470X_RDS_DECODE_EON | SI470X_RDS_DECODE_AF))
+#else
+#define SI470X_RDS_DECODERS SI470X_RDS_DECODE_ALL
+#endif
+#endif
+
+#define SI470X_RDS_HAS(decoder) ((SI470X_RDS_DECODERS & (decoder)) != 0) //!< true if the decoder is compiled in (see SI470X_RDS_DECODERS)
+
+/**
+ * Radio text work buffer (64 bytes of RAM). With it, a new message is assembled apart and published only when it is complete.
+ * Without it (0), the message is assembled in rds_buffer2A/rds_buffer2B and the characters show up as they arrive.
+ * Define SI470X_RDS_RT_WORK to override the platform default.
+ */
+#ifndef SI470X_RDS_RT_WORK
+#if defined(SI470X_ATTINY) || defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_RT_WORK 0
+#else
+#define SI470X_RDS_RT_WORK 1
+#endif
+#endif
+
+/**
+ * RDS statistics (see SI470X::getRdsStats): group types, block errors, synchronization losses and group rate. About 90 bytes of RAM.
+ * Define SI470X_RDS_STATS to override the platform default (0 removes them).
+ */
+#ifndef SI470X_RDS_STATS
+#if defined(SI470X_ATTINY) || defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_STATS 0
+#else
+#define SI470X_RDS_STATS 1
+#endif
+#endif
+
+#define SI470X_RDS_RATE_WINDOW 2000 //!< Period in ms of the RDS group rate measurement (see SI470X::getRdsStats)
+
+/**
+ * I2C bus counters (see SI470X::getBusStats). 24 bytes of RAM on AVR.
+ * Define SI470X_BUS_STATS to override the platform default (0 removes them: getBusStats returns zeros).
+ */
+#ifndef SI470X_BUS_STATS
+#if defined(SI470X_ATTINY) || defined(ARDUINO_ARCH_AVR)
+#define SI470X_BUS_STATS 0
+#else
+#define SI470X_BUS_STATS 1
+#endif
+#endif
+
+/**
+ * RDS block counters, accepted and rejected by the error threshold (see SI470X::getRdsBlockStats). 32 bytes of RAM.
+ * Define SI470X_RDS_BLOCK_STATS to override the platform default (0 removes them: getRdsBlockStats returns zeros).
+ */
+#ifndef SI470X_RDS_BLOCK_STATS
+#if defined(SI470X_ATTINY) || defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_BLOCK_STATS 0
+#else
+#define SI470X_RDS_BLOCK_STATS 1
+#endif
+#endif
+
+/**
+ * RDS FIFO counters: received, dropped and missed groups (see SI470X::getRdsFifoStats). 13 bytes of RAM.
+ * Define SI470X_RDS_FIFO_STATS to override the platform default (0 removes them: getRdsFifoStats returns zeros).
+ */
+#ifndef SI470X_RDS_FIFO_STATS
+#if defined(SI470X_ATTINY) || defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_FIFO_STATS 0
+#else
+#define SI470X_RDS_FIFO_STATS 1
+#endif
+#endif
+
+/**
+ * Seek statistics (see SI470X::getSeekStats). 18 bytes of RAM on AVR.
+ * Define SI470X_SEEK_STATS to override the platform default (0 removes them: getSeekStats returns zeros).
+ */
+#ifndef SI470X_SEEK_STATS
+#if defined(SI470X_ATTINY) || defined(ARDUINO_ARCH_AVR)
+#define SI470X_SEEK_STATS 0
+#else
+#define SI470X_SEEK_STATS 1
+#endif
+#endif
+
+/**
+ * RDS callbacks: SI470X::onProgramServiceChanged, onRadioTextChanged, onClockTime and onPtyChanged. 8 bytes of RAM on AVR.
+ * Define SI470X_RDS_CALLBACKS to override the platform default (0 removes them: the functions do nothing).
+ */
+#ifndef SI470X_RDS_CALLBACKS
+#if defined(SI470X_ATTINY)
+#define SI470X_RDS_CALLBACKS 0
+#else
+#define SI470X_RDS_CALLBACKS 1
+#endif
+#endif
+
+/**
+ * Traffic mode (see SI470X::setRdsTrafficMode and SI470X::onTrafficAnnouncement). 16 bytes of RAM on AVR.
+ * Define SI470X_RDS_TRAFFIC to override the platform default (0 removes it: the TA flags are ignored and the functions do nothing).
+ */
+#ifndef SI470X_RDS_TRAFFIC
+#if defined(SI470X_ATTINY)
+#define SI470X_RDS_TRAFFIC 0
+#else
+#define SI470X_RDS_TRAFFIC 1
+#endif
+#endif
+
+/**
+ * Size of a recorded RDS group (see SI470X::setRdsRecorder). All 16 bits values are stored high byte first.
+ *
+ * | Bytes | Content |
+ * | ----- | ------- |
+ * | 0-1   | Time in ms since the previous recorded group (65535 = 65535 or more) |
+ * | 2-9   | Blocks A, B, C and D |
+ * | 10    | Block errors (BLERA to BLERD, packed like si470x_rds_group::bler) |
+ */
+#define SI470X_RDS_RECORD_SIZE 11
+
+#define SI470X_RDS_GROUP_TIME 80 //!< A new RDS group comes every 87.6 ms. Without interrupt, the same group read again before this time (ms) is ignored.
+
+/**
+ * Number of Alternative Frequencies kept for the current station (see SI470X::getRdsAf). The RDS list has up to 25.
+ * Define SI470X_RDS_AF_SIZE to override the platform default.
+ */
+#ifndef SI470X_RDS_AF_SIZE
+#if defined(SI470X_ATTINY)
+#define SI470X_RDS_AF_SIZE 4
+#elif defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_AF_SIZE 12
+#else
+#define SI470X_RDS_AF_SIZE 25
+#endif
+#endif
+
+#define SI470X_AF_RSSI_THRESHOLD 20  //!< Default RSSI (dBuV) below which the AF follow mode looks for a better frequency (see SI470X::setRdsAfFollow)
+#define SI470X_AF_CHECK_INTERVAL 1000 //!< Interval in ms between two RSSI checks of the AF follow mode
+#define SI470X_AF_CHECK_MAX 32000    //!< Max interval in ms between two AF rounds. It doubles after each round that finds nothing better.
+#define SI470X_AF_PI_TIMEOUT 300     //!< Max time in ms waiting for the PI code on an Alternative Frequency (about 3 groups)
+
+#if SI470X_RDS_AF_SIZE > 32
+#error "SI470X_RDS_AF_SIZE must not exceed 32 (see SI470X::afFailed)"
+#endif
+
+#define SI470X_AF_IDLE 0     //!< AF follow mode: checking the RSSI of the tuned frequency
+#define SI470X_AF_PROBE 1    //!< AF follow mode: tunes the next Alternative Frequency not tried yet
+#define SI470X_AF_WAIT_PI 2  //!< AF follow mode: waiting for the RSSI and the PI code of the Alternative Frequency
+#define SI470X_AF_UNMUTE 3   //!< AF follow mode: restores the audio after the round
+
+/**
+ * Number of Other Networks (EON, group 14) kept for the tuned station (see SI470X::getRdsEon). Each one takes 4 bytes of RAM.
+ * Define SI470X_RDS_EON_SIZE to override the platform default (0 removes the EON decoder).
+ */
+#ifndef SI470X_RDS_EON_SIZE
+#if defined(SI470X_ATTINY)
+#define SI470X_RDS_EON_SIZE 0
+#elif defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_EON_SIZE 4
+#else
+#define SI470X_RDS_EON_SIZE 8
+#endif
+#endif
+
+#if !SI470X_RDS_HAS(SI470X_RDS_DECODE_EON)
+#undef SI470X_RDS_EON_SIZE
+#define SI470X_RDS_EON_SIZE 0
+#endif
+
+/**
+ * Program Type names returned by SI470X::getRdsProgramTypeName. Define SI470X_RBDS to use the North American (RBDS) names.
+ * The names are stored in the program memory (flash).
+ */
+#define SI470X_RDS_PTY_NAME_SIZE 17 //!< Buffer size for a Program Type name (16 characters and the terminator)
+
+/**
+ * Number of RadioText Plus tags kept (see SI470X::getRdsRtPlus). Each tag takes 3 bytes of RAM.
+ * Define SI470X_RDS_RTPLUS_SIZE to override the platform default (0 removes the RT+ decoder).
+ */
+#ifndef SI470X_RDS_RTPLUS_SIZE
+#if defined(SI470X_ATTINY)
+#define SI470X_RDS_RTPLUS_SIZE 0
+#elif defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_RTPLUS_SIZE 4
+#else
+#define SI470X_RDS_RTPLUS_SIZE 8
+#endif
+#endif
+
+#if !SI470X_RDS_HAS(SI470X_RDS_DECODE_ODA) || !SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+#undef SI470X_RDS_RTPLUS_SIZE
+#define SI470X_RDS_RTPLUS_SIZE 0 // RT+ needs the group 3A and the radio text
+#endif
+
+#define SI470X_RDS_AID_RTPLUS 0x4BD7 //!< Application Identification (ODA, group 3A) of the RadioText Plus
+
+// RadioText Plus content types (see SI470X::getRdsRtPlus)
+#define SI470X_RTPLUS_ITEM_TITLE 1
+#define SI470X_RTPLUS_ITEM_ALBUM 2
+#define SI470X_RTPLUS_ITEM_TRACKNUMBER 3
+#define SI470X_RTPLUS_ITEM_ARTIST 4
+#define SI470X_RTPLUS_ITEM_COMPOSITION 5
+#define SI470X_RTPLUS_ITEM_MOVEMENT 6
+#define SI470X_RTPLUS_ITEM_CONDUCTOR 7
+#define SI470X_RTPLUS_ITEM_COMPOSER 8
+#define SI470X_RTPLUS_ITEM_BAND 9
+#define SI470X_RTPLUS_ITEM_COMMENT 10
+#define SI470X_RTPLUS_ITEM_GENRE 11
+
+/**
+ * Number of application RDS handlers (see SI470X::addRdsGroupHandler and SI470X::addRdsOdaHandler). Each one takes 3 bytes of RAM
+ * plus a function pointer. Define SI470X_RDS_HANDLER_SIZE to override the platform default (0 removes the registry).
+ */
+#ifndef SI470X_RDS_HANDLER_SIZE
+#if defined(SI470X_ATTINY)
+#define SI470X_RDS_HANDLER_SIZE 0
+#elif defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_HANDLER_SIZE 4
+#else
+#define SI470X_RDS_HANDLER_SIZE 8
+#endif
+#endif
+
+#define SI470X_RDS_GROUP(type, version) (((type) << 1) | (version)) //!< Group code used by the RDS handlers: SI470X_RDS_GROUP(11, 0) is 11A
+#define SI470X_RDS_NO_GROUP 0xFF //!< No group (for example, an ODA not announced yet)
+#define SI470X_RDS_ODA_GROUPS 0x4FEFFE80UL //!< Group codes that can carry an ODA (bit n = code n): 3B, 4B, 5A to 9B, 10B, 11A to 13B and 15A
+
+#define SI470X_TRAFFIC_VOLUME 12    //!< Default volume of the traffic announcements (see SI470X::setRdsTrafficMode)
+#define SI470X_TRAFFIC_TIMEOUT 5000 //!< Max time in ms on an EON traffic station until its own TA flag confirms the announcement
+
+/**
+ * Number of stations kept by the RDS cache (see SI470X::clearRdsCache). Each station takes sizeof(si470x_rds_cache_entry) bytes of RAM:
+ * 11 bytes, + 65 with the RT decoder and + 1 + SI470X_RDS_AF_SIZE with the AF decoder (76 bytes with the AVR defaults).
+ * Define SI470X_RDS_CACHE_SIZE to override the platform default (0 removes the cache).
+ */
+#ifndef SI470X_RDS_CACHE_SIZE
+#if defined(SI470X_ATTINY) || defined(ARDUINO_ARCH_AVR)
+#define SI470X_RDS_CACHE_SIZE 0
+#else
+#define SI470X_RDS_CACHE_SIZE 8
+#endif
+#endif
+
+#ifndef SI470X_RDS_PI_CONFIRM
+#define SI470X_RDS_PI_CONFIRM 2 //!< Default number of consecutive receptions of the same PI code before it is accepted (see SI470X::setRdsPiConfirm)
+#endif
+
+#define SI470X_RDS_BLOCK_A 8 //!< Block A bit in the valid block masks used by the RDS decoders
+#define SI470X_RDS_BLOCK_B 4 //!< Block B bit
+#define SI470X_RDS_BLOCK_C 2 //!< Block C bit
+#define SI470X_RDS_BLOCK_D 1 //!< Block D bit
+
 #define FM_BAND_USA_EU 0     //!< 87.5–108 MHz (US / Europe, Default)
 #define FM_BAND_JAPAN_WIDE 1 //!< 76–108 MHz (Japan wide band)
 #define FM_BAND_JAPAN 2      //!< 76–90 MHz (Japan)
@@ -420,6 +771,7 @@ typedef union
  * ATTENTION:
  * To make it compatible with 8, 16 and 32 bits platforms and avoid Crosses boundary, it was necessary to
  * use uint32_t data type.
+ * The library does not use it anymore: the mjd field crosses the 32 bits boundary. See SI470X::getRdsClockTime.
  */
 typedef union
 {
@@ -434,6 +786,21 @@ typedef union
     uint8_t raw[6];
 } si470x_rds_date_time;
 
+/**
+ * @ingroup GA01
+ * @brief RDS clock time and date (group 4A)
+ * @see SI470X::getRdsClockTime
+ */
+typedef struct
+{
+    uint16_t year;  //!< Year (for example, 2020)
+    uint8_t month;  //!< 1 to 12
+    uint8_t day;    //!< 1 to 31
+    uint8_t hour;   //!< 0 to 23
+    uint8_t minute; //!< 0 to 59
+    int8_t offset;  //!< Local time offset in half hours (-24 to 24). 0 if already converted to local time.
+} si470x_rds_clock_time;
+
 /**
  * @ingroup GA01
  * @brief Converts 16 bits word to two bytes
@@ -448,6 +815,270 @@ typedef union
     uint16_t raw;
 } word16_to_bytes;
 
+/**
+ * @ingroup GA01
+ * @brief I2C bus traffic counters
+ * @details Accumulated by setAllRegisters. Useful to check how many bytes the register cache saves.
+ * @see getBusStats, resetBusStats
+ */
+typedef struct
+{
+    uint32_t writeTransactions; //!< Number of write transactions sent to the device.
+    uint32_t bytesWritten;      //!< Number of register bytes sent to the device.
+    uint32_t bytesSaved;        //!< Number of register bytes not sent because the device already had the content.
+    uint32_t readTransactions;  //!< Number of read transactions.
+    uint32_t bytesRead;         //!< Number of register bytes read from the device.
+    uint32_t readMicros;        //!< Time spent in read transactions, in microseconds (including the wait strategy. See SI470X_READ_WAIT).
+} si470x_bus_stats;
+
+/**
+ * @ingroup GA01
+ * @brief Seek statistics
+ * @details Times are measured from seekAsync (or seek) to STC, in milliseconds.
+ * @see getSeekStats, resetSeekStats
+ */
+typedef struct
+{
+    uint16_t count;     //!< Seeks started
+    uint16_t found;     //!< Seeks that found a station
+    uint16_t failed;    //!< Seeks that failed or reached the band limit
+    uint16_t cancelled; //!< Seeks aborted
+    uint16_t lastTime;  //!< Time of the latest finished seek
+    uint16_t minTime;   //!< Shortest seek
+    uint16_t maxTime;   //!< Longest seek
+    uint32_t totalTime; //!< Sum of the times of all finished seeks (divide by found + failed to get the average)
+} si470x_seek_stats;
+
+/**
+ * @ingroup GA01
+ * @brief RDS group (blocks A to D) as captured by the RDS FIFO
+ * @details bler packs the block error levels (see si470x_reg0a and si470x_reg0b): BLERA on bits 7-6, BLERB on bits 5-4, BLERC on bits 3-2 and BLERD on bits 1-0.
+ * @details BLERA is only reported in verbose mode (RDSM = 1). In standard mode, the device only delivers groups without uncorrectable errors.
+ * @see SI470X::getRdsGroup
+ */
+typedef struct
+{
+    uint16_t blockA; //!< PI code
+    uint16_t blockB; //!< Group type, version, TP, PTY and group specific bits. See si470x_rds_blockb
+    uint16_t blockC; //!< Group specific data
+    uint16_t blockD; //!< Group specific data
+    uint8_t bler;    //!< Block errors (2 bits per block)
+} si470x_rds_group;
+
+/**
+ * @ingroup GA01
+ * @brief RDS FIFO counters
+ * @details Use them to size the FIFO (SI470X_RDS_FIFO_SIZE) for the slowest part of your loop.
+ * @see SI470X::getRdsFifoStats
+ */
+typedef struct
+{
+    uint32_t received; //!< Groups stored in the FIFO
+    uint32_t dropped;  //!< Groups lost because the FIFO was full (the loop did not call getRdsGroup often enough)
+    uint32_t missed;   //!< Groups lost in the device because rdsCapture was not called before the next one (more than one GPIO2 pulse per capture)
+    uint8_t maxUsed;   //!< Highest number of groups waiting in the FIFO
+} si470x_rds_fifo_stats;
+
+/**
+ * @ingroup GA01
+ * @brief RDS block counters (blocks accepted and rejected by the error threshold)
+ * @details Index 0 is block A, 1 is block B, 2 is block C and 3 is block D.
+ * @see SI470X::setRdsErrorThreshold, SI470X::getRdsBlockStats
+ */
+typedef struct
+{
+    uint32_t accepted[4]; //!< Blocks with error level (BLER) up to the threshold
+    uint32_t rejected[4]; //!< Blocks discarded (BLER above the threshold)
+} si470x_rds_block_stats;
+
+/**
+ * @ingroup GA01
+ * @brief RDS reception statistics (see SI470X::getRdsStats)
+ * @details The 16 bits counters wrap around: use the difference between two readings.
+ */
+typedef struct
+{
+    uint32_t groups;          //!< Groups decoded
+    uint32_t validGroups;     //!< Groups with the four blocks accepted by the error threshold
+    uint16_t groupTypes[16];  //!< Groups with a valid block B per group type (versions A and B together)
+    uint16_t versionB;        //!< Groups of version B (valid block B)
+    uint16_t bler[4][4];      //!< Block error histogram: bler[block][BLER]. Block 0 = A to 3 = D; BLER 0 = no errors to 3 = uncorrectable (verbose mode only)
+    uint16_t syncLosses;      //!< RDS synchronization losses (RDSS from 1 to 0) on the tuned channel
+    uint16_t groupRate;       //!< Groups per second multiplied by 10 (nominal 114), measured every SI470X_RDS_RATE_WINDOW ms
+    uint32_t lastValidAge;    //!< Time in ms since the latest valid group (0xFFFFFFFF = none)
+} si470x_rds_stats;
+
+/**
+ * @ingroup GA01
+ * @brief RDS recorder sink: receives each raw group captured as a SI470X_RDS_RECORD_SIZE bytes record
+ * @see SI470X::setRdsRecorder
+ */
+typedef void (*si470x_rds_sink)(const uint8_t *record, uint8_t size);
+
+/**
+ * @ingroup GA01
+ * @brief RDS data of a station kept by the RDS cache
+ * @see SI470X::clearRdsCache
+ */
+typedef struct
+{
+    uint16_t pi;    //!< PI code (0 = free entry)
+    uint8_t pty;    //!< Program Type (0xFF = none)
+    char ps[8];     //!< Station name (not terminated)
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    uint8_t rt2B;   //!< 1 if the radio text came from the group 2B
+    char rt[64];    //!< Last radio text (terminated if shorter than 64)
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    uint8_t afCount; //!< Number of Alternative Frequencies
+    uint8_t af[SI470X_RDS_AF_SIZE]; //!< Alternative Frequencies (RDS codes)
+#endif
+} si470x_rds_cache_entry;
+
+/**
+ * @ingroup GA01
+ * @brief Other Network (EON) referenced by the tuned station (group 14A/14B)
+ * @see SI470X::getRdsEon
+ */
+typedef struct
+{
+    uint16_t pi;        //!< PI code of the other network
+    uint8_t af;         //!< Frequency of the other network (RDS code: 1 = 87.6 MHz to 204 = 107.9 MHz. 0 = unknown)
+    uint8_t mapped : 1; //!< 1 if af is the mapped frequency of the tuned frequency (variants 5 to 9)
+    uint8_t tp : 1;     //!< Traffic Program (TP) of the other network
+    uint8_t ta : 1;     //!< Traffic Announcement (TA) of the other network
+    uint8_t dummy : 5;
+} si470x_rds_eon;
+
+/**
+ * @ingroup GA01
+ * @brief RadioText Plus tag: a part of the RadioText with a content type (title, artist, ...)
+ * @see SI470X::getRdsRtPlus
+ */
+typedef struct
+{
+    uint8_t type;   //!< Content type (see SI470X_RTPLUS_ITEM_TITLE, ...)
+    uint8_t start;  //!< Position of the first character in the RadioText
+    uint8_t length; //!< Number of characters
+} si470x_rds_rtplus_tag;
+
+/**
+ * @ingroup GA01
+ * @brief Application RDS handler: called with each decoded group of the registered group type (or ODA)
+ * @details valid has the blocks with acceptable errors (SI470X_RDS_BLOCK_A to SI470X_RDS_BLOCK_D).
+ * @see SI470X::addRdsGroupHandler, SI470X::addRdsOdaHandler
+ */
+typedef void (*si470x_rds_handler)(const si470x_rds_group *group, uint8_t valid);
+
+/**
+ * @ingroup GA01
+ * @brief Application RDS handler registration
+ */
+typedef struct
+{
+    uint16_t aid;               //!< Application Identification (ODA) or 0 for a fixed group type
+    uint8_t group;              //!< Group code (SI470X_RDS_GROUP) or SI470X_RDS_NO_GROUP while the ODA is not announced
+    si470x_rds_handler handler; //!< Function called with the groups
+} si470x_rds_handler_entry;
+
+/**
+ * @ingroup GA01
+ * @brief I2C bus transport used by the SI470X class
+ * @details All the register traffic goes through this interface. The default implementation uses the Arduino Wire library (see SI470XWireBus).
+ * @details You can implement your own transport to use a second I2C bus, a faster driver, or a simulated device (see SI470XSim.h).
+ * @details The SI470X device has no register address phase. Writes always start at register 0x02 and reads always start at register 0x0A.
+ * @see SI470X::setBus
+ */
+class SI470XBus
+{
+public:
+    /**
+     * @brief Starts the bus
+     */
+    virtual void begin(){};
+
+    /**
+     * @brief Releases the bus
+     */
+    virtual void end(){};
+
+    /**
+     * @brief Writes a sequence of bytes to the device
+     * @param address  I2C device address
+     * @param data     bytes to be sent
+     * @param size     number of bytes
+     * @return 0 if success; otherwise an error code (same codes of Wire.endTransmission)
+     */
+    virtual uint8_t write(uint8_t address, const uint8_t *data, uint8_t size) = 0;
+
+    /**
+     * @brief Reads a sequence of bytes from the device
+     * @param address  I2C device address
+     * @param data     buffer that will receive the bytes
+     * @param size     number of bytes
+     * @return number of bytes read
+     */
+    virtual uint8_t read(uint8_t address, uint8_t *data, uint8_t size) = 0;
+
+    /**
+     * @brief Writes a sequence of bytes and then reads a sequence of bytes from the device
+     * @details Transports that support combined transactions (see SI470XLinuxBus) can override it to do both in one round trip.
+     * @param address  I2C device address
+     * @param wdata    bytes to be sent
+     * @param wsize    number of bytes to be sent
+     * @param rdata    buffer that will receive the bytes
+     * @param rsize    number of bytes to be read
+     * @return number of bytes read (0 if the write failed)
+     */
+    virtual uint8_t writeRead(uint8_t address, const uint8_t *wdata, uint8_t wsize, uint8_t *rdata, uint8_t rsize)
+    {
+        if (write(address, wdata, wsize) != 0)
+            return 0;
+        return read(address, rdata, rsize);
+    };
+
+    /**
+     * @brief Checks if there is a device on a given address
+     * @param address  I2C device address
+     * @return 0 if a device acknowledged; 4 if unknown error; other values if no device
+     */
+    virtual uint8_t probe(uint8_t address) { return write(address, NULL, 0); };
+};
+
+#if defined(ARDUINO)
+/**
+ * @ingroup GA01
+ * @brief SI470XBus implementation based on the Arduino Wire library (default transport)
+ * @details Use it with a second TwoWire instance if your board has more than one I2C bus.
+ * @code
+ * SI470XWireBus bus1(&Wire1);
+ * SI470X rx;
+ *
+ * void setup() {
+ *   rx.setBus(&bus1);
+ *   rx.setup(RESET_PIN, SDA_PIN);
+ * }
+ * @endcode
+ */
+class SI470XWireBus : public SI470XBus
+{
+protected:
+    TwoWire *wire;
+
+public:
+    SI470XWireBus(TwoWire *wire = &Wire) { this->wire = wire; };
+    void begin() { wire->begin(); };
+    void end() { wire->end(); };
+    uint8_t write(uint8_t address, const uint8_t *data, uint8_t size);
+    uint8_t read(uint8_t address, uint8_t *data, uint8_t size);
+};
+
+extern SI470XWireBus si470xDefaultBus; //!< Transport used when setBus is not called.
+#define SI470X_DEFAULT_BUS &si470xDefaultBus
+#else
+#define SI470X_DEFAULT_BUS NULL // There is no default transport on host builds. Call setBus.
+#endif
+
 /**
  * @ingroup GA01
  * @brief KT0915 Class
@@ -460,6 +1091,11 @@ class SI470X
 
 private:
     uint16_t shadowRegisters[17]; //!< shadow registers
+    uint16_t deviceRegisters[6];  //!< Last known content of the device registers 0x02 to 0x07 (written or read)
+#if SI470X_BUS_STATS
+    si470x_bus_stats busStats = {0, 0, 0, 0, 0, 0}; //!< I2C bus traffic counters
+#endif
+    SI470XBus *bus = SI470X_DEFAULT_BUS;          //!< I2C transport
 
     // Device registers map - References to the shadow registers
     si470x_reg00 *reg00 = (si470x_reg00 *)&shadowRegisters[REG00];
@@ -484,10 +1120,117 @@ private:
     uint16_t fmSpace[4] = {20, 10, 5, 1};              //!< FM channel space
 
 protected:
+    // Each decoder keeps its state only if it is compiled in (see SI470X_RDS_DECODERS)
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
     char rds_buffer2A[65]; //!<  RDS Radio Text buffer - Program Information
     char rds_buffer2B[33]; //!<  RDS Radio Text buffer - Station Informaation
-    char rds_buffer0A[9];  //!<  RDS Basic tuning and switching information (Type 0 groups)
+#endif
+    char rds_buffer0A[9];  //!<  RDS Basic tuning and switching information (Type 0 groups). Only complete names are published here.
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PS)
+    char rdsPsWork[8];              //!<  Station name being assembled (segments of the groups 0A/0B)
+    uint8_t rdsPsReady = 0;         //!<  Segments of rdsPsWork ready to be published (bit 0 = segment 0)
+    bool rdsPsConfirm = false;      //!<  If true, each segment must be received twice with the same content
+#endif
+    uint8_t rdsPsVersion = 0;       //!<  Incremented every time rds_buffer0A changes
+    uint16_t rdsPsPi = 0;           //!<  PI code of the station that sent rds_buffer0A (see storeRdsCache)
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PTYN)
+    char rdsPtyn[9];                //!<  Program Type Name (group 10A). Only complete names are published here.
+    char rdsPtynWork[8];            //!<  Program Type Name being assembled
+    uint8_t rdsPtynReady = 0;       //!<  Segments of rdsPtynWork received (bit 0 = segment 0)
+    uint8_t rdsPtynFlagAB = 0xFF;   //!<  A/B flag of the name being assembled (0xFF = none)
+#endif
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    si470x_rds_rtplus_tag rdsRtPlus[SI470X_RDS_RTPLUS_SIZE]; //!<  RadioText Plus tags (most recent first)
+    uint8_t rdsRtPlusCount = 0;     //!<  Number of tags in rdsRtPlus
+    uint8_t rdsRtPlusGroup = 0xFF;  //!<  Group carrying the RT+ tags: group type * 2 + version (0xFF = no RT+ announced in group 3A)
+    uint8_t rdsRtPlusToggle = 0xFF; //!<  Item toggle bit of the current item
+    bool rdsRtPlusRunning = false;  //!<  Item running bit
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+#if SI470X_RDS_RT_WORK
+    char rdsRtWork[64];             //!<  Radio text being assembled (groups 2A/2B)
+#else
+    bool rdsRtChanged = false;      //!<  Text assembled in place changed since it was last published
+#endif
+    uint16_t rdsRtSegments = 0;     //!<  Segments of the radio text received (bit 0 = segment 0)
+    uint8_t rdsRtEnd = 64;          //!<  Length of the text being assembled (position of the 0x0D or the maximum)
+    uint8_t rdsRtFlagAB = 0xFF;     //!<  Text A/B flag of the message being assembled (0xFF = none)
+    uint8_t rdsRtVersionCode = 0;   //!<  0 = 2A; 1 = 2B
+    uint8_t rdsRtVersion = 0;       //!<  Incremented every time rds_buffer2A or rds_buffer2B changes
+    uint16_t rdsRtPi = 0;           //!<  PI code of the station that sent rds_buffer2A / rds_buffer2B (see storeRdsCache)
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
     char rds_time[20];     //!<  RDS date time received information
+    uint32_t rdsClockMjd;           //!<  Modified Julian Day of the latest group 4A
+    uint16_t rdsClockMinutes;       //!<  UTC time of the latest group 4A in minutes since midnight
+    int8_t rdsClockOffset;          //!<  Local time offset of the latest group 4A in half hours
+    uint8_t rdsClockVersion = 0;    //!<  Incremented on each valid group 4A (0 = no time received)
+#endif
+    uint8_t rdsPty = 0xFF;          //!<  Latest Program Type (0xFF = none)
+    uint16_t rdsPi = 0;             //!<  Confirmed PI code (0 = none)
+    uint16_t rdsPiCandidate = 0;    //!<  PI code being confirmed
+    uint8_t rdsPiCount = 0;         //!<  Consecutive receptions of rdsPiCandidate
+    uint8_t rdsPiConfirm = SI470X_RDS_PI_CONFIRM; //!<  Receptions needed to confirm a PI code
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PIN)
+    uint8_t rdsEcc = 0;             //!<  Extended Country Code (group 1A, variant 0. 0 = none)
+    uint8_t rdsLanguage = 0;        //!<  Language code (group 1A, variant 3. 0 = unknown)
+    uint16_t rdsPin = 0;            //!<  Program Item Number (groups 1A/1B. day 0 = none)
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    uint8_t rdsAf[SI470X_RDS_AF_SIZE]; //!<  Alternative Frequencies (RDS codes: 1 = 87.6 MHz to 204 = 107.9 MHz)
+    uint8_t rdsAfCount = 0;         //!<  Number of Alternative Frequencies in rdsAf
+    uint16_t rdsAfPi = 0;           //!<  PI code of the station of the list (0 = not known yet)
+    bool rdsAfMethodB = false;      //!<  true if the station sends the AF list by method B (pairs with the tuned frequency)
+    bool afFollow = false;          //!<  AF follow mode (see setRdsAfFollow)
+    uint8_t afRssiThreshold = SI470X_AF_RSSI_THRESHOLD; //!<  RSSI below which the AF follow mode looks for a better frequency
+    unsigned long afCheckTime = 0;  //!<  Time of the latest RSSI check of the AF follow mode (or of the start of the current AF probe)
+    uint16_t afCheckInterval = SI470X_AF_CHECK_INTERVAL; //!<  Interval between two RSSI checks (backoff, see SI470X_AF_CHECK_MAX)
+    uint32_t afFailed = 0;          //!<  Alternative Frequencies that failed (bit n = rdsAf[n]). Cleared when the list changes.
+    uint16_t afReturnFrequency = 0; //!<  Frequency of the station before the current AF round
+    uint8_t afState = SI470X_AF_IDLE; //!<  AF follow state machine. See checkRdsAf
+    uint8_t afIndex = 0;            //!<  Next Alternative Frequency to try (index of rdsAf)
+    uint8_t afRssi = 0;             //!<  RSSI of afReturnFrequency. An AF must be better.
+    uint8_t afDmute = 0;            //!<  DMUTE before the current AF round
+#endif
+#if SI470X_RDS_EON_SIZE > 0
+    si470x_rds_eon rdsEon[SI470X_RDS_EON_SIZE]; //!<  Other Networks (most recent first)
+    uint8_t rdsEonCount = 0;        //!<  Number of Other Networks in rdsEon
+#endif
+#if SI470X_RDS_TRAFFIC
+    bool rdsTrafficAnnouncement = false; //!<  Latest TP && TA (groups 0A/0B)
+    bool trafficMode = false;       //!<  Traffic mode (see setRdsTrafficMode)
+    bool trafficEon = false;        //!<  If true, the traffic mode switches to the EON traffic stations
+    bool trafficAudio = false;      //!<  true while the traffic mode has raised the volume and unmuted
+    bool trafficConfirmed = false;  //!<  true after the EON traffic station confirmed the announcement (its own TA)
+    uint8_t trafficVolume = SI470X_TRAFFIC_VOLUME; //!<  Volume of the traffic announcements
+    uint8_t trafficDmute;           //!<  DMUTE before the traffic announcement
+    uint16_t trafficReturnFrequency = 0; //!<  Frequency to return to after an EON traffic announcement (0 = not switched)
+    unsigned long trafficSwitchTime; //!<  Time of the switch to the EON traffic station
+    void (*trafficAnnouncementHandler)(bool active) = NULL; //!<  See onTrafficAnnouncement
+#endif
+#if SI470X_RDS_CACHE_SIZE > 0
+    si470x_rds_cache_entry rdsCache[SI470X_RDS_CACHE_SIZE]; //!<  Stations listened to (most recent first)
+    bool rdsCacheLookup = false;    //!<  If true, the next valid block A is looked up in the cache
+#endif
+#if SI470X_RDS_HANDLER_SIZE > 0
+    si470x_rds_handler_entry rdsHandlers[SI470X_RDS_HANDLER_SIZE]; //!<  Application RDS handlers
+    uint32_t rdsHandlerGroups = 0;  //!<  Group codes with at least one handler (bit n = group code n)
+    uint8_t rdsHandlerCount = 0;    //!<  Number of handlers in rdsHandlers
+#endif
+
+#if SI470X_RDS_CALLBACKS
+    // RDS callbacks. See onProgramServiceChanged, onRadioTextChanged, onClockTime and onPtyChanged
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PS)
+    void (*programServiceHandler)(const char *ps) = NULL;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    void (*radioTextHandler)(const char *text) = NULL;
+#endif
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
+    void (*clockTimeHandler)(const si470x_rds_clock_time *ct) = NULL;
+#endif
+    void (*ptyHandler)(uint8_t pty) = NULL;
+#endif
 
     int deviceAddress = I2C_DEVICE_ADDR;
     int resetPin;
@@ -501,11 +1244,91 @@ protected:
     uint16_t maxDelayAftarCrystalOn = MAX_DELAY_AFTER_OSCILLATOR;
 
     char strFrequency[8]; // Used to store formated frequency
-    
+
+    uint8_t tuneState = SI470X_TUNE_IDLE;       //!< Tune state machine. See poll()
+    uint16_t pendingChannel = SI470X_NO_CHANNEL; //!< Channel to be tuned when the current operation finishes (or by the next poll)
+    uint8_t pendingRetune = SI470X_RETUNE_USER;  //!< Reason of the pending tune (SI470X_RETUNE_USER or SI470X_RETUNE_TRAFFIC)
+    uint8_t pendingSeek = SI470X_NO_SEEK;        //!< Seek to be started when the current operation finishes: (seek_mode << 1) | direction
+    unsigned long tuneStart;                     //!< millis() when the current tune or seek started
+    unsigned long lastPoll;                      //!< millis() of the latest status read done by poll()
+    volatile bool stcInterrupt = false;          //!< Set by the GPIO2 interrupt handler when STC goes high. See seekInterruptPin
+    volatile uint8_t rdsPulses = 0;              //!< GPIO2 pulses not yet handled by rdsCapture. See rdsInterruptPin
+
+    si470x_rds_group rdsFifo[SI470X_RDS_FIFO_SIZE] = {}; //!< RDS groups captured and not yet read. See rdsCapture and getRdsGroup
+    uint8_t rdsFifoHead = 0;                        //!< Free running write index (rdsCapture)
+    uint8_t rdsFifoTail = 0;                        //!< Free running read index (getRdsGroup)
+#if SI470X_RDS_FIFO_STATS
+    si470x_rds_fifo_stats rdsFifoStats = {0, 0, 0, 0}; //!< See getRdsFifoStats
+#endif
+    unsigned long rdsCaptureTime = 0; //!< millis() of the latest group stored
+    uint8_t rdsErrorThreshold = 0xAA;  //!< Highest BLER accepted for each block, packed like si470x_rds_group::bler (default 2: 3-5 corrected errors)
+#if SI470X_RDS_BLOCK_STATS
+    si470x_rds_block_stats rdsBlockStats = {{0, 0, 0, 0}, {0, 0, 0, 0}}; //!< See getRdsBlockStats
+#endif
+    si470x_rds_sink rdsRecorder = NULL; //!< See setRdsRecorder
+    unsigned long rdsRecordTime = 0;  //!< millis() of the latest recorded group
+#if SI470X_RDS_STATS
+    si470x_rds_stats rdsStats;        //!< See getRdsStats
+    unsigned long rdsRateStart = 0;   //!< Start of the current group rate measurement
+    uint16_t rdsRateGroups = 0;       //!< Groups decoded since rdsRateStart
+    unsigned long rdsValidTime = 0;   //!< millis() of the latest valid group
+    bool rdsSynced = false;           //!< Latest RDSS read (synchronization losses)
+#endif
+
+    static SI470X *interruptReceiver; //!< Receiver whose GPIO2 is attached to an interrupt (one per sketch)
+    static void SI470X_ISR_ATTR gpio2InterruptHandler();
+
+#if SI470X_SEEK_STATS
+    si470x_seek_stats seekStats = {0, 0, 0, 0, 0, 0xFFFF, 0, 0}; //!< Seek statistics
+#endif
+    void (*seekEventHandler)(uint8_t event, uint16_t frequency) = NULL; //!< See setSeekEventHandler
+
     void reset();
     void powerUp();
     void powerDown();
     void waitAndFinishTune();
+    void startTune(uint16_t channel, uint8_t retune = SI470X_RETUNE_USER);
+    void startSeek(uint8_t seek_mode, uint8_t direction);
+    bool tuneStep();
+    void seekFinished(uint8_t event);
+
+    /**
+     * @ingroup GA03
+     * @brief Converts a channel (CHAN or READCHAN) to frequency (MHz x 100)
+     */
+    inline uint16_t channelToFrequency(uint16_t channel) { return channel * this->fmSpace[this->currentFMSpace] + this->startBand[this->currentFMBand]; };
+
+    /**
+     * @ingroup GA03
+     * @brief Converts a frequency (MHz x 100) to channel (CHAN)
+     */
+    inline uint16_t frequencyToChannel(uint16_t frequency) { return (frequency - this->startBand[this->currentFMBand]) / this->fmSpace[this->currentFMSpace]; };
+    uint8_t readBytes(uint8_t *data, uint8_t size);
+    uint8_t writeBytes(const uint8_t *data, uint8_t size);
+    uint8_t writeReadBytes(const uint8_t *wdata, uint8_t wsize, uint8_t *rdata, uint8_t rsize);
+    void flushRegisters(uint8_t limit, bool readStatus);
+    void processRdsGroup0(const si470x_rds_group *group, uint8_t valid);
+    void processRdsGroup2(const si470x_rds_group *group, uint8_t valid);
+    void processRdsPi(uint16_t pi);
+    void processRdsAf(uint8_t code1, uint8_t code2);
+    void addRdsAf(uint8_t code);
+    void failRdsAf();
+    void processRdsGroup3A(const si470x_rds_group *group, uint8_t valid);
+    void processRdsRtPlus(const si470x_rds_group *group, uint8_t valid);
+    void addRdsRtPlusTag(uint8_t type, uint8_t start, uint8_t length);
+    void callRdsHandlers(uint8_t code, const si470x_rds_group *group, uint8_t valid);
+    void countRdsGroup(const si470x_rds_group *group, uint8_t valid);
+    void updateRdsRate();
+    void updateRdsHandlerGroups();
+    void unbindRdsOda();
+    void processRdsGroup10A(const si470x_rds_group *group, uint8_t valid);
+    void processRdsGroup14(const si470x_rds_group *group, uint8_t valid);
+    void updateTrafficAnnouncement(bool active);
+    void changeRdsStation(uint8_t retune = SI470X_RETUNE_USER);
+    void storeRdsCache();
+    void loadRdsCache(uint16_t pi);
+    void processRdsGroup1(const si470x_rds_group *group, uint8_t valid);
+    void processRdsGroup4A(const si470x_rds_group *group, uint8_t valid);
 
 public:
     /**
@@ -524,13 +1347,15 @@ public:
      */
     inline void setDelayAfterCrystalOn(uint8_t ms_value) { maxDelayAftarCrystalOn = ms_value; };
     void getAllRegisters();
+    void getRegisters(uint8_t count);
     void setAllRegisters(uint8_t limit = 0x07);
+    void setAllRegistersAndGetStatus(uint8_t limit = 0x07);
     void getStatus();
 
     /**
      * @ingroup GA03
      * @brief Get the Shadown Register object
-     * @details if you want to get the current value of the device register, call getAllRegisters() before calling this function.
+     * @details if you want to get the current value of the device register, call getAllRegisters() (or getRegisters) before calling this function.
      * @details if you are dealing with the status register (0x0A), you can call getStatus() instead getAllRegisters().
      * @see setAllRegisters, getAllRegisters, getShadownRegister, getStatus
      * @param register_number
@@ -538,6 +1363,43 @@ public:
      */
     inline uint16_t getShadownRegister(uint8_t register_number) { return shadowRegisters[register_number]; };
 
+    uint16_t getDirtyRegisters();
+
+    /**
+     * @ingroup GA03
+     * @brief Gets the I2C bus traffic counters
+     * @details Use it to check how many register bytes were sent and how many were saved by skipping unchanged registers.
+     * @see resetBusStats, setAllRegisters
+     * @return si470x_bus_stats (all zeros if SI470X_BUS_STATS is 0)
+     */
+#if SI470X_BUS_STATS
+    inline si470x_bus_stats getBusStats() { return busStats; };
+#else
+    inline si470x_bus_stats getBusStats() { return si470x_bus_stats(); };
+#endif
+
+    /**
+     * @ingroup GA03
+     * @brief Resets the I2C bus traffic counters
+     * @see getBusStats
+     */
+    inline void resetBusStats()
+    {
+#if SI470X_BUS_STATS
+        memset(&busStats, 0, sizeof(busStats));
+#endif
+    };
+
+    /**
+     * @ingroup GA03
+     * @brief Sets the I2C transport
+     * @details This function must to be called before setup function if you are not using the default Wire bus.
+     * @details On host builds (no Arduino core) there is no default transport, so this function is mandatory.
+     * @see SI470XBus, SI470XWireBus
+     * @param bus  transport implementation
+     */
+    inline void setBus(SI470XBus *bus) { this->bus = bus; };
+
     /**
      * @ingroup GA03
      * @brief Sets a given value to the Shadown Register
@@ -553,8 +1415,8 @@ public:
         shadowRegisters[register_number] = value;
     };
 
-    void setup(int resetPin, int sdaPin, int rdsInterruptPin = -1, int seekInterruptPin = -1, uint8_t oscillator_type = OSCILLATOR_TYPE_CRYSTAL);
-    void setup(int resetPin, int sdaPin, uint8_t oscillator_type);
+    void setup(int resetPin, int sdaPin, int rdsInterruptPin = -1, int seekInterruptPin = -1, uint8_t oscillator_type = OSCILLATOR_TYPE_CRYSTAL, size_t layout = sizeof(SI470X));
+    void setup(int resetPin, int sdaPin, uint8_t oscillator_type, size_t layout = sizeof(SI470X));
     // void setupDebug(int resetPin, int sdaPin, int rdsInterruptPin, int seekInterruptPin, uint8_t oscillator_type, void (*showFunc)(byte v));
     void setFrequency(uint16_t frequency);
     void setFrequencyUp();
@@ -563,8 +1425,86 @@ public:
     uint16_t getRealFrequency();
     uint16_t getRealChannel();
     void setChannel(uint16_t channel);
+    void setChannelAsync(uint16_t channel);
+    void setFrequencyAsync(uint16_t frequency);
+    bool poll();
+
+    /**
+     * @ingroup GA03
+     * @brief Checks if the latest tune or seek has finished
+     * @details It does not use the I2C bus. Call poll() to move the tune state machine forward.
+     * @see poll, setFrequencyAsync, setChannelAsync
+     * @return true if there is no tune or seek in progress
+     */
+    inline bool isTuneComplete() { return this->tuneState == SI470X_TUNE_IDLE; };
+
+    /**
+     * @ingroup GA03
+     * @brief Gets the tune state machine state
+     * @return SI470X_TUNE_IDLE, SI470X_TUNE_WAIT_STC or SI470X_TUNE_WAIT_CLEAR
+     */
+    inline uint8_t getTuneState() { return this->tuneState; };
+
+    /**
+     * @ingroup GA03
+     * @brief Checks if tune and seek completion is signaled by the STC interrupt (GPIO2)
+     * @details It is true when a seekInterruptPin was passed to setup.
+     * @see setup, poll
+     * @return true if STC interrupt is enabled
+     */
+    inline bool isStcInterruptEnabled() { return this->seekInterruptPin >= 0; };
     void seek(uint8_t seek_mode, uint8_t direction);
     void seek(uint8_t seek_mode, uint8_t direction, void (*showFunc)());
+    void seekAsync(uint8_t seek_mode, uint8_t direction);
+    bool cancelSeek();
+
+    /**
+     * @ingroup GA03
+     * @brief Checks if a seek is in progress
+     * @return true if seeking
+     */
+    inline bool isSeeking() { return this->tuneState == SI470X_TUNE_WAIT_STC && reg02->refined.SEEK; };
+
+    /**
+     * @ingroup GA03
+     * @brief Sets the function called on seek events
+     * @details The function receives the event (SI470X_SEEK_EVENT_PROGRESS, SI470X_SEEK_EVENT_FOUND, SI470X_SEEK_EVENT_FAILED or SI470X_SEEK_EVENT_CANCELLED)
+     * @details and the current frequency (MHz x 100). It is called from poll().
+     * @code
+     * void onSeek(uint8_t event, uint16_t frequency) {
+     *   showFrequency(frequency);
+     * }
+     *
+     * rx.setSeekEventHandler(onSeek);
+     * rx.seekAsync(SI470X_SEEK_WRAP, SI470X_SEEK_UP);
+     * @endcode
+     * @see seekAsync, poll
+     * @param handler  function or NULL
+     */
+    inline void setSeekEventHandler(void (*handler)(uint8_t event, uint16_t frequency)) { this->seekEventHandler = handler; };
+
+    /**
+     * @ingroup GA03
+     * @brief Gets the seek statistics (count, results and times)
+     * @return si470x_seek_stats (all zeros if SI470X_SEEK_STATS is 0)
+     */
+#if SI470X_SEEK_STATS
+    inline si470x_seek_stats getSeekStats() { return this->seekStats; };
+#else
+    inline si470x_seek_stats getSeekStats() { return si470x_seek_stats(); };
+#endif
+
+    /**
+     * @ingroup GA03
+     * @brief Resets the seek statistics
+     */
+    inline void resetSeekStats()
+    {
+#if SI470X_SEEK_STATS
+        memset(&this->seekStats, 0, sizeof(this->seekStats));
+        this->seekStats.minTime = 0xFFFF;
+#endif
+    };
     void setSeekThreshold(uint8_t value);
 
     void setBand(uint8_t band = 1);
@@ -602,6 +1542,110 @@ public:
     void setFmDeemphasis(uint8_t de);
 
     void getRdsStatus();
+    bool rdsCapture();
+    bool getRdsGroup(si470x_rds_group *group);
+    bool processRdsGroup();
+    void processRdsGroup(const si470x_rds_group *group);
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the number of RDS groups waiting in the RDS FIFO
+     * @see rdsCapture, getRdsGroup
+     */
+    inline uint8_t getRdsGroupCount() { return (uint8_t)(this->rdsFifoHead - this->rdsFifoTail); };
+
+    /**
+     * @ingroup GA04
+     * @brief Discards the RDS groups waiting in the RDS FIFO
+     * @details It is called when a new channel is tuned.
+     */
+    inline void clearRdsFifo() { this->rdsFifoTail = this->rdsFifoHead; };
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the RDS FIFO counters (received, dropped and missed groups)
+     * @return si470x_rds_fifo_stats (all zeros if SI470X_RDS_FIFO_STATS is 0)
+     */
+#if SI470X_RDS_FIFO_STATS
+    inline si470x_rds_fifo_stats getRdsFifoStats() { return this->rdsFifoStats; };
+#else
+    inline si470x_rds_fifo_stats getRdsFifoStats() { return si470x_rds_fifo_stats(); };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Resets the RDS FIFO counters
+     */
+    inline void resetRdsFifoStats()
+    {
+#if SI470X_RDS_FIFO_STATS
+        memset(&this->rdsFifoStats, 0, sizeof(this->rdsFifoStats));
+#endif
+    };
+
+    /**
+     * @ingroup GA04
+     * @brief Checks if RDS ready is signaled by the GPIO2 interrupt
+     * @details It is true when a rdsInterruptPin was passed to setup.
+     */
+    inline bool isRdsInterruptEnabled() { return this->rdsInterruptPin >= 0; };
+    void setRdsErrorThreshold(uint8_t blockA, uint8_t blockB, uint8_t blockC, uint8_t blockD);
+
+    /**
+     * @ingroup GA04
+     * @brief Sets the same error threshold to all RDS blocks
+     * @see setRdsErrorThreshold(uint8_t blockA, uint8_t blockB, uint8_t blockC, uint8_t blockD)
+     * @param threshold  0 to 3
+     */
+    inline void setRdsErrorThreshold(uint8_t threshold) { setRdsErrorThreshold(threshold, threshold, threshold, threshold); };
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the number of RDS blocks accepted and rejected by the error threshold
+     * @see setRdsErrorThreshold
+     * @return si470x_rds_block_stats (all zeros if SI470X_RDS_BLOCK_STATS is 0)
+     */
+#if SI470X_RDS_BLOCK_STATS
+    inline si470x_rds_block_stats getRdsBlockStats() { return this->rdsBlockStats; };
+#else
+    inline si470x_rds_block_stats getRdsBlockStats() { return si470x_rds_block_stats(); };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Resets the RDS block counters
+     */
+    inline void resetRdsBlockStats()
+    {
+#if SI470X_RDS_BLOCK_STATS
+        memset(&this->rdsBlockStats, 0, sizeof(this->rdsBlockStats));
+#endif
+    };
+    si470x_rds_stats getRdsStats();
+    void resetRdsStats();
+
+    /**
+     * @ingroup GA04
+     * @brief Sets the function that receives the raw RDS groups (binary recorder)
+     * @details Each group read from the device (with its block errors, before the error threshold and the decoders) is passed
+     * @details as a SI470X_RDS_RECORD_SIZE bytes record. Save the records (Serial, SD card, ...) to reproduce field problems:
+     * @details on a computer, SI470XRdsReplay (SI470XSim.h) feeds them into the same decoder. See decodeRdsRecord.
+     * @code
+     * void recordGroup(const uint8_t *record, uint8_t size) {
+     *   Serial.write(record, size);
+     * }
+     *
+     * rx.setRdsRecorder(recordGroup);
+     * @endcode
+     * @param sink  function or NULL (stops recording)
+     */
+    inline void setRdsRecorder(si470x_rds_sink sink)
+    {
+        this->rdsRecorder = sink;
+        this->rdsRecordTime = millis();
+    };
+    static void encodeRdsRecord(const si470x_rds_group *group, uint16_t delta, uint8_t *record);
+    static uint16_t decodeRdsRecord(const uint8_t *record, si470x_rds_group *group);
     void setRdsMode(uint8_t rds_mode = 0);
     void setRds(bool value);
     inline void setRDS(bool value) { setRds(value); };
@@ -611,6 +1655,51 @@ public:
     uint8_t getRdsVersionCode(void);
     uint16_t getRdsGroupType();
     uint8_t getRdsProgramType(void);
+    static const char *getRdsProgramTypeNameP(uint8_t pty);
+    static char *getRdsProgramTypeName(uint8_t pty, char *buffer);
+    char *getRdsProgramTypeName(char *buffer);
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the Program Type Name (PTYN, group 10A) sent by the station
+     * @details It describes the program type in more detail than the PTY code (for example, "Football" for PTY Sport).
+     * @details It does not use the I2C bus. Please, check if getRdsReady (or processRdsGroup) was called before.
+     * @return char* the 8 characters name or NULL if it was not received
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PTYN)
+    inline char *getRdsProgramTypeNameText(void) { return (rdsPtyn[0] != '\0') ? rdsPtyn : NULL; };
+#else
+    inline char *getRdsProgramTypeNameText(void) { return NULL; };
+#endif
+
+    bool getRdsRtPlus(uint8_t type, const char **text, uint8_t *length);
+
+    /**
+     * @ingroup GA04
+     * @brief Checks if the station sends RadioText Plus (announced in the group 3A)
+     * @return true if the RT+ application was found
+     */
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    inline bool isRdsRtPlus() { return this->rdsRtPlusGroup != 0xFF; };
+#else
+    inline bool isRdsRtPlus() { return false; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Checks the RadioText Plus item running bit
+     * @return true while an item (song, ...) is being played. The tags describe it.
+     */
+#if SI470X_RDS_RTPLUS_SIZE > 0
+    inline bool isRdsRtPlusItemRunning() { return this->rdsRtPlusRunning; };
+#else
+    inline bool isRdsRtPlusItemRunning() { return false; };
+#endif
+
+    bool addRdsGroupHandler(uint8_t code, si470x_rds_handler handler);
+    bool addRdsOdaHandler(uint16_t aid, si470x_rds_handler handler);
+    void removeRdsHandler(si470x_rds_handler handler);
+    uint8_t getRdsOdaGroup(uint16_t aid);
     void getNext2Block(char *c);
     void getNext4Block(char *c);
     char *getRdsText(void);
@@ -621,7 +1710,8 @@ public:
      * @brief Gets the Program Information (RT - Radio Text)
      * @details Process the program information data. Same getRdsText2A(). It is a alias for getRdsText2A.
      * @details ATTENTION: You must call getRdsReady before calling this function.
-     * @return char array with the program information (63 bytes)
+     * @details Only complete messages are returned (see getRdsTextVersion).
+     * @return char array with the program information (up to 64 characters)
      * @see getRdsText2A
      */
     inline char *getRdsProgramInformation(void) { return getRdsText2A(); };
@@ -630,7 +1720,8 @@ public:
      * @ingroup GA04
      * @brief Gets the Station Information.
      * @details ATTENTION: You must call getRdsReady before calling this function.
-     * @return char array with the Text of Station Information (33 bytes)
+     * @details It is the radio text sent by group 2B. Only complete messages are returned (see getRdsTextVersion).
+     * @return char array with the Text of Station Information (up to 32 characters)
      * @see getRdsReady
      */
     inline char *getRdsStationInformation(void) { return getRdsText2B(); };
@@ -645,10 +1736,340 @@ public:
      */
     inline char *getRdsStationName(void) { return getRdsText0A(); };
 
+    /**
+     * @ingroup GA04
+     * @brief Gets the station name version
+     * @details It changes every time a new (different) station name is published. Redraw the name only when it changes.
+     * @code
+     * if (rx.getRdsStationNameVersion() != shownVersion) {
+     *   shownVersion = rx.getRdsStationNameVersion();
+     *   showStationName(rx.getRdsStationName());
+     * }
+     * @endcode
+     * @see getRdsStationName, setRdsStationNameConfirm
+     * @return uint8_t version counter
+     */
+    inline uint8_t getRdsStationNameVersion(void) { return this->rdsPsVersion; };
+
+    /**
+     * @ingroup GA04
+     * @brief Requires each station name segment to be received twice with the same content before publishing the name
+     * @details It filters transmission errors not detected by the block error levels. Stations that scroll text in the name (dynamic PS) will not be shown.
+     * @see getRdsStationName
+     * @param value true = two consistent receptions; false = one reception (default)
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PS)
+    inline void setRdsStationNameConfirm(bool value) { this->rdsPsConfirm = value; };
+#else
+    inline void setRdsStationNameConfirm(bool value) { (void)value; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the radio text version
+     * @details It changes every time a new (different) complete radio text (2A or 2B) is published.
+     * @see getRdsProgramInformation, getRdsStationInformation
+     * @return uint8_t version counter
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    inline uint8_t getRdsTextVersion(void) { return this->rdsRtVersion; };
+#else
+    inline uint8_t getRdsTextVersion(void) { return 0; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the radio text segments received so far for the message being assembled
+     * @details Bit 0 is the segment 0 (characters 0 to 3 on 2A, 0 and 1 on 2B). Useful to show the reception progress.
+     * @return uint16_t segment mask
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    inline uint16_t getRdsTextSegments(void) { return this->rdsRtSegments; };
+#else
+    inline uint16_t getRdsTextSegments(void) { return 0; };
+#endif
+
     char *getRdsText2A(void);
     char *getRdsText2B(void);
+    bool getRdsClockTime(si470x_rds_clock_time *ct, bool localTime = false);
+
+    /**
+     * @ingroup GA04
+     * @brief Sets the function called when a new (different) station name is complete
+     * @details The RDS callbacks are called from processRdsGroup (or getRdsReady), only when the decoded content changes.
+     * @code
+     * void showPs(const char *ps) {
+     *   lcd.setCursor(0, 0);
+     *   lcd.print(ps);
+     * }
+     *
+     * rx.onProgramServiceChanged(showPs);
+     * .
+     * .
+     * void loop() {
+     *   rx.processRdsGroup(); // No display work until something changes
+     * }
+     * @endcode
+     * @see getRdsStationName, processRdsGroup
+     * @param handler  function or NULL
+     */
+#if SI470X_RDS_CALLBACKS && SI470X_RDS_HAS(SI470X_RDS_DECODE_PS)
+    inline void onProgramServiceChanged(void (*handler)(const char *ps)) { this->programServiceHandler = handler; };
+#else
+    inline void onProgramServiceChanged(void (*handler)(const char *ps)) { (void)handler; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Sets the function called when a new (different) radio text (2A or 2B) is complete
+     * @see getRdsText2A, getRdsText2B
+     * @param handler  function or NULL
+     */
+#if SI470X_RDS_CALLBACKS && SI470X_RDS_HAS(SI470X_RDS_DECODE_RT)
+    inline void onRadioTextChanged(void (*handler)(const char *text)) { this->radioTextHandler = handler; };
+#else
+    inline void onRadioTextChanged(void (*handler)(const char *text)) { (void)handler; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Sets the function called when a new clock time (group 4A, once a minute) is received
+     * @details A repeated group 4A with the same time does not call it. The function receives the local date and time (see getRdsClockTime).
+     * @param handler  function or NULL
+     */
+#if SI470X_RDS_CALLBACKS && SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
+    inline void onClockTime(void (*handler)(const si470x_rds_clock_time *ct)) { this->clockTimeHandler = handler; };
+#else
+    inline void onClockTime(void (*handler)(const si470x_rds_clock_time *ct)) { (void)handler; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Sets the function called when the Program Type (PTY) changes
+     * @param handler  function or NULL
+     */
+#if SI470X_RDS_CALLBACKS
+    inline void onPtyChanged(void (*handler)(uint8_t pty)) { this->ptyHandler = handler; };
+#else
+    inline void onPtyChanged(void (*handler)(uint8_t pty)) { (void)handler; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Sets the function called when a traffic announcement starts or stops on the tuned station (TP = 1 and TA = 1)
+     * @param handler  function or NULL
+     */
+#if SI470X_RDS_TRAFFIC
+    inline void onTrafficAnnouncement(void (*handler)(bool active)) { this->trafficAnnouncementHandler = handler; };
+#else
+    inline void onTrafficAnnouncement(void (*handler)(bool active)) { (void)handler; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the clock time version
+     * @details It changes every time a new valid group 4A (clock time, sent once a minute) is received. 0 means no time received.
+     * @see getRdsClockTime
+     * @return uint8_t version counter
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_CT)
+    inline uint8_t getRdsClockTimeVersion() { return this->rdsClockVersion; };
+#else
+    inline uint8_t getRdsClockTimeVersion() { return 0; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the Program Identification (PI) code of the station
+     * @details The PI code comes in the block A of every group (and in the block C of the version B groups). It is unique for each
+     * @details program in a country. A new PI is accepted only after it is received SI470X_RDS_PI_CONFIRM times in a row (see setRdsPiConfirm).
+     * @details A tune or seek clears it: it stays 0 on a station without RDS.
+     * @return uint16_t PI code or 0 if no PI was confirmed since the latest tune or seek
+     * @see isSameStation, getRdsCountryCode
+     */
+    inline uint16_t getRdsPi() { return this->rdsPi; };
+
+    /**
+     * @ingroup GA04
+     * @brief Checks if the tuned station is a given station
+     * @details It just compares PI codes. Useful to check that an alternative frequency carries the same program before switching to it.
+     * @details The PI code is cleared by every tune or seek, so it is false until the new station confirms the same PI code (never on a station without RDS).
+     * @code
+     * uint16_t pi = rx.getRdsPi();
+     * rx.setFrequency(af);
+     * .
+     * . // call rx.getRdsReady() for a few hundred ms
+     * .
+     * if (!rx.isSameStation(pi))
+     *   rx.setFrequency(previous);
+     * @endcode
+     * @param pi  PI code
+     * @return true if the PI code confirmed since the latest tune or seek is pi
+     */
+    inline bool isSameStation(uint16_t pi) { return pi != 0 && this->rdsPi == pi; };
+
+    /**
+     * @ingroup GA04
+     * @brief Sets the number of consecutive receptions of the same PI code needed to accept it
+     * @param count  1 (accept the first valid block) to 255. Default SI470X_RDS_PI_CONFIRM
+     */
+    inline void setRdsPiConfirm(uint8_t count) { this->rdsPiConfirm = (count == 0) ? 1 : count; };
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the country code (first nibble of the PI code)
+     * @details The same code is shared by several countries. Use it with the Extended Country Code (getRdsEcc) to identify the country.
+     * @return uint8_t 1 to 15 or 0 if no PI was confirmed yet
+     */
+    inline uint8_t getRdsCountryCode() { return this->rdsPi >> 12; };
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the Extended Country Code (ECC) sent in the group 1A (variant 0)
+     * @return uint8_t ECC (for example, 0xE0 for Germany with country code 0xD) or 0 if it was not received
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PIN)
+    inline uint8_t getRdsEcc() { return this->rdsEcc; };
+#else
+    inline uint8_t getRdsEcc() { return 0; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the language code sent in the group 1A (variant 3)
+     * @return uint8_t language code (see EN 50067 Annex J) or 0 if unknown
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_PIN)
+    inline uint8_t getRdsLanguageCode() { return this->rdsLanguage; };
+#else
+    inline uint8_t getRdsLanguageCode() { return 0; };
+#endif
+
+    bool getRdsProgramItemNumber(uint8_t *day, uint8_t *hour, uint8_t *minute);
+
+    void clearRdsCache();
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the number of Alternative Frequencies received (groups 0A) for the current station
+     * @see getRdsAf
+     * @return uint8_t 0 to SI470X_RDS_AF_SIZE
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    inline uint8_t getRdsAfCount() { return this->rdsAfCount; };
+#else
+    inline uint8_t getRdsAfCount() { return 0; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Gets an Alternative Frequency of the current station
+     * @details Frequencies broadcasting the same program (regional variants of the method B lists are not included).
+     * @details A method A list (one list for the whole network) usually has the tuned frequency too.
+     * @code
+     * for (uint8_t i = 0; i < rx.getRdsAfCount(); i++)
+     *   Serial.println(rx.getRdsAf(i)); // 10390 means 103.9 MHz
+     * @endcode
+     * @param index  0 to getRdsAfCount() - 1
+     * @return uint16_t frequency (MHz multiplied by 100) or 0 if index is out of range
+     */
+    inline uint16_t getRdsAf(uint8_t index)
+    {
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+        return (index < this->rdsAfCount) ? 8750 + this->rdsAf[index] * 10 : 0;
+#else
+        (void)index;
+        return 0;
+#endif
+    };
+
+    /**
+     * @ingroup GA04
+     * @brief Checks the AF method used by the station
+     * @return true if method B (each transmitter sends its own list); false if method A (one list for the network)
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    inline bool isRdsAfMethodB() { return this->rdsAfMethodB; };
+#else
+    inline bool isRdsAfMethodB() { return false; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Sets the AF follow mode
+     * @details When the RSSI of the tuned frequency drops below rssiThreshold, the receiver tries the Alternative Frequencies
+     * @details of the station and switches to the first one with a better signal and the same PI code. See checkRdsAf.
+     * @details The check runs from poll() (call it from your loop) or by calling checkRdsAf. Each call does one step and uses the I2C bus at most once.
+     * @param value  true = follow the station; false = stay on the tuned frequency (default)
+     * @param rssiThreshold  RSSI in dBuV (default SI470X_AF_RSSI_THRESHOLD)
+     */
+    inline void setRdsAfFollow(bool value, uint8_t rssiThreshold = SI470X_AF_RSSI_THRESHOLD)
+    {
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+        this->afFollow = value;
+        this->afRssiThreshold = rssiThreshold;
+#else
+        (void)value;
+        (void)rssiThreshold;
+#endif
+    };
+
+    bool checkRdsAf();
+
+    /**
+     * @ingroup GA04
+     * @brief Checks if the AF follow mode is trying the Alternative Frequencies (audio muted, RDS decoding suspended)
+     * @see setRdsAfFollow, checkRdsAf
+     */
+#if SI470X_RDS_HAS(SI470X_RDS_DECODE_AF)
+    inline bool isRdsAfSearching() { return this->afState != SI470X_AF_IDLE; };
+#else
+    inline bool isRdsAfSearching() { return false; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Gets the number of Other Networks (EON) referenced by the tuned station
+     * @see getRdsEon
+     * @return uint8_t 0 to SI470X_RDS_EON_SIZE
+     */
+#if SI470X_RDS_EON_SIZE > 0
+    inline uint8_t getRdsEonCount() { return this->rdsEonCount; };
+#else
+    inline uint8_t getRdsEonCount() { return 0; };
+#endif
+
+    /**
+     * @ingroup GA04
+     * @brief Gets an Other Network (EON) referenced by the tuned station (groups 14A and 14B)
+     * @param index  0 to getRdsEonCount() - 1
+     * @return pointer to the Other Network data or NULL if index is out of range
+     */
+    inline const si470x_rds_eon *getRdsEon(uint8_t index)
+    {
+#if SI470X_RDS_EON_SIZE > 0
+        return (index < this->rdsEonCount) ? &this->rdsEon[index] : NULL;
+#else
+        (void)index;
+        return NULL;
+#endif
+    };
+
+    /**
+     * @ingroup GA04
+     * @brief Checks if the receiver is on an EON traffic station (see setRdsTrafficMode)
+     * @return true while a traffic announcement of an other network is being listened to
+     */
+#if SI470X_RDS_TRAFFIC
+    inline bool isRdsTrafficSwitched() { return this->trafficReturnFrequency != 0; };
+#else
+    inline bool isRdsTrafficSwitched() { return false; };
+#endif
+
+    void setRdsTrafficMode(bool value, uint8_t volume = SI470X_TRAFFIC_VOLUME, bool eon = true);
     char *getRdsTime();
     char *getRdsLocalTime();
+    char *getRdsLocalDateTime();
     bool getRdsSync();
     void clearRdsBuffer();
     void adjustRdsText(char *text, int size);
@@ -670,4 +2091,6 @@ public:
         this->convertToChar(this->currentFrequency, this->strFrequency, 5, 3, decimalSeparator, true);
         return this->strFrequency;
     };
-};
\ No newline at end of file
+};
+
+#endif
@@ -0,0 +1,117 @@
+/**
+ * @file SI470XHost.cpp
+ * @brief Minimal Arduino API replacement used to build the SI470X library on a host (Linux, macOS)
+ * @details Nothing here is compiled by the Arduino IDE.
+ *
+ * This library can be freely distributed using the MIT Free Software model.
+ * Copyright (c) 2020 Ricardo Lima Caratti.
+ * Contact: pu2clr@gmail.com
+ */
+
+#if !defined(ARDUINO)
+
+#include "SI470XHost.h"
+#include <time.h>
+
+#define HOST_INTERRUPTS 8
+
+static bool virtualClock = false;
+static uint64_t virtualMicros = 0;
+static void (*timeHandler)(void) = NULL;
+static void (*interruptHandler[HOST_INTERRUPTS])(void);
+
+static uint64_t hostMicros()
+{
+    struct timespec ts;
+
+    if (virtualClock)
+        return virtualMicros;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+void si470xHostUseVirtualClock(bool value)
+{
+    virtualClock = value;
+}
+
+void si470xHostAdvance(unsigned long us)
+{
+    virtualMicros += us;
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    struct timespec ts;
+
+    if (virtualClock)
+        virtualMicros += us;
+    else
+    {
+        ts.tv_sec = us / 1000000;
+        ts.tv_nsec = (long)(us % 1000000) * 1000;
+        nanosleep(&ts, NULL);
+    }
+    if (timeHandler != NULL)
+        timeHandler();
+}
+
+void si470xHostSetTimeHandler(void (*handler)(void))
+{
+    timeHandler = handler;
+}
+
+void delay(unsigned long ms)
+{
+    while (ms > 1000)
+    {
+        delayMicroseconds(1000000);
+        ms -= 1000;
+    }
+    delayMicroseconds((unsigned int)(ms * 1000));
+}
+
+unsigned long millis()
+{
+    return (unsigned long)(hostMicros() / 1000);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)hostMicros();
+}
+
+// There are no GPIOs on the host. The reset pin is ignored.
+void pinMode(int pin, int mode)
+{
+    (void)pin;
+    (void)mode;
+}
+
+void digitalWrite(int pin, int value)
+{
+    (void)pin;
+    (void)value;
+}
+
+// The interrupts are raised by software (see si470xHostInterrupt). The mode is ignored.
+void attachInterrupt(int interrupt, void (*handler)(void), int mode)
+{
+    (void)mode;
+    if (interrupt >= 0 && interrupt < HOST_INTERRUPTS)
+        interruptHandler[interrupt] = handler;
+}
+
+void detachInterrupt(int interrupt)
+{
+    if (interrupt >= 0 && interrupt < HOST_INTERRUPTS)
+        interruptHandler[interrupt] = NULL;
+}
+
+void si470xHostInterrupt(int pin)
+{
+    if (pin >= 0 && pin < HOST_INTERRUPTS && interruptHandler[pin] != NULL)
+        interruptHandler[pin]();
+}
+
+#endif
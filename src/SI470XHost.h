@@ -0,0 +1,84 @@
+/**
+ * @file SI470XHost.h
+ * @brief Minimal Arduino API replacement used to build the SI470X library on a host (Linux, macOS)
+ * @details This file is only used when the library is not compiled by an Arduino core (ARDUINO not defined).
+ * @details It provides the few Arduino functions the library needs (delay, millis, pinMode ...).
+ * @details The clock can run in real time or in virtual time. In virtual time, delay() just advances the clock.
+ * @details It is useful to run the library against a simulated device (see SI470XSim.h) without waiting for the real tune and seek times.
+ *
+ * This library can be freely distributed using the MIT Free Software model.
+ * Copyright (c) 2020 Ricardo Lima Caratti.
+ * Contact: pu2clr@gmail.com
+ */
+
+#ifndef SI470X_HOST_H
+#define SI470X_HOST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+typedef uint8_t byte;
+
+// Program memory (flash) access. On the host, constant data is in RAM.
+#define PROGMEM
+#define PGM_P const char *
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define memcpy_P memcpy
+
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long millis();
+unsigned long micros();
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int value);
+
+/**
+ * @brief On the host, the interrupt number is the pin number
+ */
+inline int digitalPinToInterrupt(int pin) { return pin; }
+inline void noInterrupts() {}
+inline void interrupts() {}
+void attachInterrupt(int interrupt, void (*handler)(void), int mode);
+void detachInterrupt(int interrupt);
+
+/**
+ * @brief Calls the handler attached to a pin (see attachInterrupt), as if the pin had changed
+ * @details Used by the simulated device (see SI470XSim::setInterruptPin) to emulate the GPIO2 pulses.
+ * @param pin  pin number
+ */
+void si470xHostInterrupt(int pin);
+
+/**
+ * @brief Sets a function called every time delay or delayMicroseconds runs
+ * @details The simulated device uses it to move forward (and raise interrupts) while the library does not use the I2C bus.
+ * @param handler  function or NULL
+ */
+void si470xHostSetTimeHandler(void (*handler)(void));
+
+/**
+ * @brief Selects virtual (true) or real (false, default) time for delay, millis and micros
+ * @details In virtual time, the clock only moves when delay, delayMicroseconds or si470xHostAdvance are called.
+ */
+void si470xHostUseVirtualClock(bool value);
+
+/**
+ * @brief Advances the virtual clock
+ * @param us  microseconds
+ */
+void si470xHostAdvance(unsigned long us);
+
+#endif
@@ -0,0 +1,141 @@
+/**
+ * @file SI470XLinuxBus.cpp
+ * @brief SI470XBus implementation for Linux i2c-dev (/dev/i2c-N)
+ * @details Nothing here is compiled by the Arduino IDE.
+ *
+ * This library can be freely distributed using the MIT Free Software model.
+ * Copyright (c) 2020 Ricardo Lima Caratti.
+ * Contact: pu2clr@gmail.com
+ */
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "SI470XLinuxBus.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+/**
+ * @brief Creates a transport for a given i2c-dev device. The device is opened by begin().
+ * @param device  device path (default /dev/i2c-1)
+ */
+SI470XLinuxBus::SI470XLinuxBus(const char *device)
+{
+    strncpy(this->device, device, sizeof(this->device) - 1);
+    this->device[sizeof(this->device) - 1] = '\0';
+    this->ownFd = true;
+}
+
+/**
+ * @brief Creates a transport for an already open i2c-dev file descriptor
+ * @details The file descriptor is not closed by end().
+ * @param fd  file descriptor
+ */
+SI470XLinuxBus::SI470XLinuxBus(int fd)
+{
+    this->device[0] = '\0';
+    this->fd = fd;
+    this->ownFd = false;
+}
+
+/**
+ * @brief Opens the i2c-dev device (if it is not open yet)
+ */
+void SI470XLinuxBus::begin()
+{
+    if (fd < 0 && ownFd)
+        fd = open(device, O_RDWR);
+}
+
+/**
+ * @brief Closes the i2c-dev device (only if it was opened by begin)
+ */
+void SI470XLinuxBus::end()
+{
+    if (fd >= 0 && ownFd)
+    {
+        close(fd);
+        fd = -1;
+    }
+}
+
+/**
+ * @brief Sends a set of messages in a single I2C_RDWR call (one STOP at the end)
+ * @details Override it to redirect the transfers (for example, to a simulated device. See SI470XSimLinuxBus).
+ * @param msgs   messages
+ * @param count  number of messages
+ * @return the ioctl result: number of messages transferred or -1 (errno set)
+ */
+int SI470XLinuxBus::transfer(struct i2c_msg *msgs, int count)
+{
+    struct i2c_rdwr_ioctl_data data;
+
+    data.msgs = msgs;
+    data.nmsgs = count;
+    return ioctl(fd, I2C_RDWR, &data);
+}
+
+/**
+ * @brief Converts the errno of a failed transfer to the Wire.endTransmission error codes
+ */
+static uint8_t linuxError()
+{
+    return (errno == ENXIO || errno == EREMOTEIO) ? 2 : 4;
+}
+
+uint8_t SI470XLinuxBus::write(uint8_t address, const uint8_t *data, uint8_t size)
+{
+    struct i2c_msg msg;
+
+    msg.addr = address;
+    msg.flags = 0;
+    msg.len = size;
+    msg.buf = (uint8_t *)data;
+    kernelCalls++;
+    return (transfer(&msg, 1) < 0) ? linuxError() : 0;
+}
+
+uint8_t SI470XLinuxBus::read(uint8_t address, uint8_t *data, uint8_t size)
+{
+    struct i2c_msg msg;
+
+    msg.addr = address;
+    msg.flags = I2C_M_RD;
+    msg.len = size;
+    msg.buf = data;
+    kernelCalls++;
+    return (transfer(&msg, 1) < 0) ? 0 : size;
+}
+
+/**
+ * @brief Writes and reads in a single combined transaction (one I2C_RDWR call)
+ * @see SI470XBus::writeRead
+ */
+uint8_t SI470XLinuxBus::writeRead(uint8_t address, const uint8_t *wdata, uint8_t wsize, uint8_t *rdata, uint8_t rsize)
+{
+    struct i2c_msg msgs[2];
+
+    msgs[0].addr = address;
+    msgs[0].flags = 0;
+    msgs[0].len = wsize;
+    msgs[0].buf = (uint8_t *)wdata;
+    msgs[1].addr = address;
+    msgs[1].flags = I2C_M_RD;
+    msgs[1].len = rsize;
+    msgs[1].buf = rdata;
+    kernelCalls++;
+    return (transfer(msgs, 2) < 0) ? 0 : rsize;
+}
+
+/**
+ * @brief Checks if a device acknowledges a given address (zero length write)
+ */
+uint8_t SI470XLinuxBus::probe(uint8_t address)
+{
+    return write(address, NULL, 0);
+}
+
+#endif
@@ -0,0 +1,68 @@
+/**
+ * @file SI470XLinuxBus.h
+ * @brief SI470XBus implementation for Linux i2c-dev (/dev/i2c-N)
+ * @details Use it to control an SI4702/03 connected to the I2C bus of a Linux single board computer (Raspberry Pi, BeagleBone, ...).
+ * @details All transfers use the I2C_RDWR ioctl. A register write followed by a status read (see SI470X::setAllRegistersAndGetStatus)
+ * @details is sent as one combined transaction, in a single kernel round trip.
+ * @code
+ * #include <SI470X.h>
+ * #include <SI470XLinuxBus.h>
+ *
+ * SI470XLinuxBus bus("/dev/i2c-1");
+ * SI470X rx;
+ *
+ * int main() {
+ *   rx.setBus(&bus);
+ *   rx.setup(-1, -1); // Reset the device by other means (for example, a GPIO driven by libgpiod)
+ *   rx.setFrequency(10390);
+ * }
+ * @endcode
+ *
+ * This library can be freely distributed using the MIT Free Software model.
+ * Copyright (c) 2020 Ricardo Lima Caratti.
+ * Contact: pu2clr@gmail.com
+ */
+
+#ifndef SI470X_LINUX_BUS_H
+#define SI470X_LINUX_BUS_H
+
+#if defined(__linux__) && !defined(ARDUINO)
+
+#include "SI470X.h"
+
+struct i2c_msg;
+
+/**
+ * @brief Linux i2c-dev transport
+ */
+class SI470XLinuxBus : public SI470XBus
+{
+protected:
+    char device[32];
+    int fd = -1;
+    bool ownFd; //!< true if the file descriptor was opened (and must be closed) by this object
+
+    virtual int transfer(struct i2c_msg *msgs, int count);
+
+public:
+    uint32_t kernelCalls = 0; //!< Number of I2C_RDWR ioctl calls (kernel round trips)
+
+    SI470XLinuxBus(const char *device = "/dev/i2c-1");
+    SI470XLinuxBus(int fd);
+
+    void begin();
+    void end();
+    uint8_t write(uint8_t address, const uint8_t *data, uint8_t size);
+    uint8_t read(uint8_t address, uint8_t *data, uint8_t size);
+    uint8_t writeRead(uint8_t address, const uint8_t *wdata, uint8_t wsize, uint8_t *rdata, uint8_t rsize);
+    uint8_t probe(uint8_t address);
+
+    /**
+     * @brief Gets the file descriptor of the I2C adapter
+     * @return file descriptor or -1 if it is not open
+     */
+    inline int getFd() { return fd; };
+};
+
+#endif
+#endif
@@ -0,0 +1,569 @@
+/**
+ * @file SI470XSim.cpp
+ * @brief Simulated SI470X device (host builds only)
+ * @details Nothing here is compiled by the Arduino IDE.
+ *
+ * This library can be freely distributed using the MIT Free Software model.
+ * Copyright (c) 2020 Ricardo Lima Caratti.
+ * Contact: pu2clr@gmail.com
+ */
+
+#if !defined(ARDUINO)
+
+#include "SI470XSim.h"
+#include <stdio.h>
+
+static const uint16_t simBandSize[4] = {10800 - 8750, 10800 - 7600, 9000 - 7600, 10800 - 7600}; // in 10 kHz
+static const uint16_t simSpace[4] = {20, 10, 5, 5};
+
+static SI470XSim *clockedSim = NULL; //!< Device moved forward by delay() (see setInterruptPin)
+
+static void simTimeHandler()
+{
+    if (clockedSim != NULL)
+        clockedSim->update();
+}
+
+/**
+ * @brief Creates a simulated device
+ * @param address  I2C address the simulated device answers to
+ */
+SI470XSim::SI470XSim(uint8_t address)
+{
+    this->address = address;
+    reset();
+}
+
+/**
+ * @brief Puts the simulated device in the power on reset state
+ */
+void SI470XSim::reset()
+{
+    memset(registers, 0, sizeof(registers));
+    registers[REG00] = 0x1242; // Silicon Labs, Si4702/03
+    registers[REG01] = 0x1200; // Rev C, Si4703 before powerup
+    registers[REG07] = 0x0100;
+    tuning = seeking = false;
+}
+
+/**
+ * @brief Number of channels of the current band and space
+ */
+uint16_t SI470XSim::channelCount()
+{
+    si470x_reg05 r05;
+    r05.raw = registers[REG05];
+    return simBandSize[r05.refined.BAND] / simSpace[r05.refined.SPACE];
+}
+
+/**
+ * @brief Station of a given channel (NULL if there is no station on it)
+ */
+const si470x_sim_station *SI470XSim::stationOf(uint16_t channel)
+{
+    for (uint8_t i = 0; i < stationCount; i++)
+        if (stations[i].channel == channel)
+            return &stations[i];
+    return NULL;
+}
+
+/**
+ * @brief RSSI of a given channel
+ */
+uint8_t SI470XSim::rssiOf(uint16_t channel)
+{
+    const si470x_sim_station *station = stationOf(channel);
+    return (station != NULL) ? station->rssi : SI470X_SIM_NOISE_RSSI;
+}
+
+/**
+ * @brief RDS groups sent on a given channel: the groups of the station or the common ones (see setRdsGroups)
+ */
+const si470x_rds_group *SI470XSim::rdsGroupsOf(uint16_t channel, uint16_t *count)
+{
+    const si470x_sim_station *station = stationOf(channel);
+    if (station != NULL && station->rdsGroups != NULL)
+    {
+        *count = station->rdsGroupCount;
+        return station->rdsGroups;
+    }
+    *count = rdsGroupCount;
+    return rdsGroups;
+}
+
+/**
+ * @brief Updates READCHAN and the RSSI/stereo status of the channel
+ */
+void SI470XSim::setReadChannel(uint16_t channel)
+{
+    si470x_reg0a r0a;
+    si470x_reg0b r0b;
+
+    r0b.raw = registers[REG0B];
+    r0b.refined.READCHAN = channel;
+    registers[REG0B] = r0b.raw;
+
+    r0a.raw = registers[REG0A];
+    r0a.refined.RSSI = rssiOf(channel);
+    r0a.refined.ST = r0a.refined.RSSI > 30;
+    r0a.refined.AFCRL = r0a.refined.RSSI == SI470X_SIM_NOISE_RSSI;
+    registers[REG0A] = r0a.raw;
+}
+
+/**
+ * @brief Finishes the current tune or seek
+ */
+void SI470XSim::setStc(bool failed)
+{
+    si470x_reg0a r0a;
+    r0a.raw = registers[REG0A];
+    r0a.refined.STC = 1;
+    r0a.refined.SF_BL = failed;
+    registers[REG0A] = r0a.raw;
+    tuning = seeking = false;
+    stcTime = rdsTime = micros();
+
+    si470x_reg04 r04;
+    r04.raw = registers[REG04];
+    if (r04.refined.STCIEN)
+        pulse();
+}
+
+/**
+ * @brief Sends a low pulse on GPIO2 (if it is configured as STC/RDS interrupt and connected. See setInterruptPin)
+ */
+void SI470XSim::pulse()
+{
+    si470x_reg04 r04;
+    r04.raw = registers[REG04];
+    if (interruptPin >= 0 && r04.refined.GPIO2 == 1)
+    {
+        interrupts++;
+        si470xHostInterrupt(interruptPin);
+    }
+}
+
+/**
+ * @brief Checks if RDS groups are being received (RDS enabled, powered up, not tuning and tuned to a station)
+ */
+bool SI470XSim::rdsActive()
+{
+    si470x_reg02 r02;
+    si470x_reg04 r04;
+    si470x_reg0b r0b;
+    uint16_t count;
+    r02.raw = registers[REG02];
+    r04.raw = registers[REG04];
+    r0b.raw = registers[REG0B];
+    rdsGroupsOf(r0b.refined.READCHAN, &count);
+    return r04.refined.RDS && r02.refined.ENABLE && !r02.refined.DISABLE && !tuning && !seeking && count > 0 &&
+           rssiOf(r0b.refined.READCHAN) > SI470X_SIM_NOISE_RSSI;
+}
+
+/**
+ * @brief Puts the next RDS group in the registers 0x0C to 0x0F and sets RDSR
+ */
+void SI470XSim::sendRdsGroup()
+{
+    const si470x_rds_group *group;
+    si470x_reg02 r02;
+    si470x_reg0a r0a;
+    si470x_reg0b r0b;
+    uint16_t count;
+
+    r0b.raw = registers[REG0B];
+    group = rdsGroupsOf(r0b.refined.READCHAN, &count);
+    group = &group[rdsIndex % count];
+    rdsIndex = (rdsIndex + 1) % count;
+    r02.raw = registers[REG02];
+
+    // Standard mode: only groups without uncorrectable blocks
+    if (!r02.refined.RDSM && ((group->bler & 0xC0) == 0xC0 || (group->bler & 0x30) == 0x30 || (group->bler & 0x0C) == 0x0C || (group->bler & 0x03) == 0x03))
+        return;
+
+    registers[REG0C] = group->blockA;
+    registers[REG0D] = group->blockB;
+    registers[REG0E] = group->blockC;
+    registers[REG0F] = group->blockD;
+
+    r0a.raw = registers[REG0A];
+    r0a.refined.RDSR = 1;
+    r0a.refined.RDSS = 1;
+    r0a.refined.BLERA = r02.refined.RDSM ? (group->bler >> 6) : 0;
+    registers[REG0A] = r0a.raw;
+
+    r0b.raw = registers[REG0B];
+    r0b.refined.BLERB = r02.refined.RDSM ? (group->bler >> 4) & 3 : 0;
+    r0b.refined.BLERC = r02.refined.RDSM ? (group->bler >> 2) & 3 : 0;
+    r0b.refined.BLERD = r02.refined.RDSM ? group->bler & 3 : 0;
+    registers[REG0B] = r0b.raw;
+
+    rdsGroupsSent++;
+
+    si470x_reg04 r04;
+    r04.raw = registers[REG04];
+    if (r04.refined.RDSIEN)
+        pulse();
+}
+
+/**
+ * @brief Connects the simulated GPIO2 to a host pin (see si470xHostInterrupt)
+ * @details When STCIEN = 1 and GPIO2 = 01, the handler attached to the pin is called as soon as STC is set.
+ * @details The device also moves forward on every delay() call, so the interrupt comes even if the library does not use the I2C bus.
+ * @details Pass the same pin as seekInterruptPin to SI470X::setup.
+ * @param pin  pin number (0 to 7) or -1 to disconnect
+ */
+void SI470XSim::setInterruptPin(int pin)
+{
+    interruptPin = pin;
+    clockedSim = (pin >= 0) ? this : NULL;
+    si470xHostSetTimeHandler((pin >= 0) ? simTimeHandler : NULL);
+}
+
+/**
+ * @brief Moves the simulation to the current time (micros)
+ */
+void SI470XSim::update()
+{
+    unsigned long now = micros();
+
+    if (tuning && (now - operationTime) >= tuneTime)
+    {
+        si470x_reg03 r03;
+        r03.raw = registers[REG03];
+        setReadChannel(r03.refined.CHAN);
+        setStc(false);
+    }
+
+    if (!tuning && !seeking)
+    {
+        si470x_reg0b r0b;
+        r0b.raw = registers[REG0B];
+        setReadChannel(r0b.refined.READCHAN); // The RSSI of the station can change (see setStations)
+    }
+
+    if (!rdsActive())
+        rdsTime = now;
+    while (rdsActive() && (now - rdsTime) >= SI470X_SIM_RDS_GROUP_TIME)
+    {
+        rdsTime += SI470X_SIM_RDS_GROUP_TIME;
+        sendRdsGroup();
+    }
+    if ((now - rdsTime) >= SI470X_SIM_RDS_READY_TIME)
+    {
+        si470x_reg0a r0a;
+        r0a.raw = registers[REG0A];
+        r0a.refined.RDSR = 0;
+        registers[REG0A] = r0a.raw;
+    }
+
+    while (seeking && (now - operationTime) >= seekStepTime)
+    {
+        si470x_reg02 r02;
+        si470x_reg05 r05;
+        si470x_reg0b r0b;
+        uint16_t channel, count = channelCount();
+
+        r02.raw = registers[REG02];
+        r05.raw = registers[REG05];
+        r0b.raw = registers[REG0B];
+        channel = r0b.refined.READCHAN;
+        operationTime += seekStepTime;
+
+        if (r02.refined.SEEKUP)
+        {
+            if (channel >= count)
+            {
+                if (r02.refined.SKMODE)
+                {
+                    setStc(true); // Band limit
+                    break;
+                }
+                channel = 0;
+            }
+            else
+                channel++;
+        }
+        else
+        {
+            if (channel == 0)
+            {
+                if (r02.refined.SKMODE)
+                {
+                    setStc(true); // Band limit
+                    break;
+                }
+                channel = count;
+            }
+            else
+                channel--;
+        }
+
+        setReadChannel(channel);
+        if (rssiOf(channel) >= r05.refined.SEEKTH && rssiOf(channel) > SI470X_SIM_NOISE_RSSI)
+            setStc(false);
+        else if (channel == seekStartChannel)
+            setStc(true); // The whole band was searched
+    }
+}
+
+/**
+ * @brief Reacts to changes in the registers 0x02 and 0x03
+ * @param old02 previous content of the register 0x02
+ * @param old03 previous content of the register 0x03
+ */
+void SI470XSim::registersWritten(uint16_t old02, uint16_t old03)
+{
+    si470x_reg02 o02, r02;
+    si470x_reg03 o03, r03;
+    si470x_reg0a r0a;
+
+    o02.raw = old02;
+    o03.raw = old03;
+    r02.raw = registers[REG02];
+    r03.raw = registers[REG03];
+
+    if (r02.refined.ENABLE && !r02.refined.DISABLE)
+        registers[REG01] = 0x1253; // Powered up: Si4703, firmware 19
+    else if (r02.refined.DISABLE)
+        registers[REG01] = 0x1200;
+
+    if (r02.refined.SEEK && !o02.refined.SEEK)
+    {
+        si470x_reg0b r0b;
+        r0b.raw = registers[REG0B];
+        seekStartChannel = r0b.refined.READCHAN;
+        seeking = true;
+        tuning = false;
+        operationTime = micros();
+    }
+    else if (r03.refined.TUNE && !o03.refined.TUNE && !r02.refined.SEEK)
+    {
+        tuning = true;
+        operationTime = micros();
+    }
+
+    // A new channel: the RDS decoder loses the synchronization
+    if (tuning || seeking)
+    {
+        r0a.raw = registers[REG0A];
+        r0a.refined.RDSR = 0;
+        r0a.refined.RDSS = 0;
+        registers[REG0A] = r0a.raw;
+    }
+
+    // Setting SEEK and TUNE low clears STC and SF/BL (and aborts a seek)
+    if (!r02.refined.SEEK && !r03.refined.TUNE)
+    {
+        r0a.raw = registers[REG0A];
+        r0a.refined.STC = 0;
+        r0a.refined.SF_BL = 0;
+        registers[REG0A] = r0a.raw;
+        tuning = seeking = false;
+    }
+}
+
+/**
+ * @brief Advances the virtual clock by the time of a transaction (address byte plus data, 9 clocks per byte)
+ */
+void SI470XSim::busTime(uint8_t size)
+{
+    si470xHostAdvance((uint32_t)(size + 1) * 9 * 1000000UL / busClock);
+}
+
+/**
+ * @brief Receives bytes from the library. The first byte goes to the upper byte of the register 0x02.
+ */
+uint8_t SI470XSim::write(uint8_t address, const uint8_t *data, uint8_t size)
+{
+    uint16_t old02 = registers[REG02], old03 = registers[REG03];
+    uint8_t reg = REG02;
+
+    if (address != this->address)
+        return 2; // NACK on address
+
+    busTime(size);
+    update();
+    writeTransactions++;
+    bytesWritten += size;
+    for (uint8_t i = 0; i + 1 < size; i += 2)
+    {
+        if (reg >= REG02 && reg <= REG09) // The other registers are read only
+            registers[reg] = (data[i] << 8) | data[i + 1];
+        reg = (reg + 1) & 0x0F;
+    }
+    registersWritten(old02, old03);
+    return 0;
+}
+
+/**
+ * @brief Sends bytes to the library. The first byte is the upper byte of the register 0x0A.
+ */
+uint8_t SI470XSim::read(uint8_t address, uint8_t *data, uint8_t size)
+{
+    uint8_t reg = REG0A;
+
+    if (address != this->address)
+        return 0;
+
+    busTime(size);
+    update();
+    readTransactions++;
+    bytesRead += size;
+    for (uint8_t i = 0; i < size; i++)
+    {
+        data[i] = (i & 1) ? (registers[reg] & 0xFF) : (registers[reg] >> 8);
+        if (i & 1)
+            reg = (reg + 1) & 0x0F;
+    }
+    return size;
+}
+
+/**
+ * @brief Acknowledges only the simulated device address
+ */
+uint8_t SI470XSim::probe(uint8_t address)
+{
+    return (address == this->address) ? 0 : 2;
+}
+
+/**
+ * @brief Creates a replay source for a recording in memory
+ * @param data  records (not copied)
+ * @param size  size in bytes
+ */
+SI470XRdsReplay::SI470XRdsReplay(const uint8_t *data, size_t size)
+{
+    setRecording(data, size);
+}
+
+SI470XRdsReplay::~SI470XRdsReplay()
+{
+    free(loaded);
+}
+
+/**
+ * @brief Sets a recording in memory and goes back to its first group
+ * @param data  records (not copied)
+ * @param size  size in bytes. An incomplete last record is ignored.
+ */
+void SI470XRdsReplay::setRecording(const uint8_t *data, size_t size)
+{
+    this->data = data;
+    this->size = size - size % SI470X_RDS_RECORD_SIZE;
+    this->position = 0;
+}
+
+/**
+ * @brief Loads a recording file (the records saved from the sink of SI470X::setRdsRecorder)
+ * @param path  file name
+ * @return false if the file could not be read
+ */
+bool SI470XRdsReplay::load(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t *buffer = NULL;
+    size_t length = 0, capacity = 0, n;
+
+    if (file == NULL)
+        return false;
+    do
+    {
+        if (length == capacity)
+        {
+            uint8_t *bigger = (uint8_t *)realloc(buffer, capacity += 4096);
+            if (bigger == NULL)
+                break;
+            buffer = bigger;
+        }
+        n = fread(buffer + length, 1, capacity - length, file);
+        length += n;
+    } while (n > 0);
+    fclose(file);
+
+    free(loaded);
+    loaded = buffer;
+    setRecording(buffer, length);
+    return buffer != NULL;
+}
+
+/**
+ * @brief Gets the next group of the recording
+ * @param group  receives the group
+ * @param delta  if not NULL, receives the time in ms since the previous group
+ * @return false at the end of the recording
+ */
+bool SI470XRdsReplay::next(si470x_rds_group *group, uint16_t *delta)
+{
+    uint16_t time;
+
+    if (position + SI470X_RDS_RECORD_SIZE > size)
+        return false;
+    time = SI470X::decodeRdsRecord(data + position, group);
+    position += SI470X_RDS_RECORD_SIZE;
+    if (delta != NULL)
+        *delta = time;
+    return true;
+}
+
+/**
+ * @brief Feeds the remaining groups into the decoder of a receiver (SI470X::processRdsGroup)
+ * @details The receiver does not need a device. Call clearRdsBuffer before to decode from a clean state.
+ * @param rx  receiver
+ * @param timed  if true, waits (delay) the recorded time before each group, so the time based features (clock,
+ *               statistics, timeouts) see the original timing. With the virtual clock (si470xHostUseVirtualClock) it does not sleep.
+ * @return number of groups decoded
+ */
+uint32_t SI470XRdsReplay::decode(SI470X &rx, bool timed)
+{
+    si470x_rds_group group;
+    uint16_t delta;
+    uint32_t count = 0;
+
+    while (next(&group, &delta))
+    {
+        if (timed)
+            delay(delta);
+        rx.processRdsGroup(&group);
+        count++;
+    }
+    return count;
+}
+
+#if defined(__linux__)
+#include <errno.h>
+#include <linux/i2c.h>
+
+/**
+ * @brief Delivers the I2C_RDWR messages to the simulated device
+ * @return number of messages transferred or -1 (errno = ENXIO) if the device does not acknowledge
+ */
+int SI470XSimLinuxBus::transfer(struct i2c_msg *msgs, int count)
+{
+    if (fd != SI470X_SIM_FAKE_FD)
+    {
+        errno = EBADF;
+        return -1;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (msgs[i].flags & I2C_M_RD)
+        {
+            if (sim->read(msgs[i].addr, msgs[i].buf, msgs[i].len) != msgs[i].len)
+            {
+                errno = ENXIO;
+                return -1;
+            }
+        }
+        else if (sim->write(msgs[i].addr, msgs[i].buf, msgs[i].len) != 0)
+        {
+            errno = ENXIO;
+            return -1;
+        }
+    }
+    return count;
+}
+#endif
+
+#endif
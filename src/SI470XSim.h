@@ -0,0 +1,254 @@
+/**
+ * @file SI470XSim.h
+ * @brief Simulated SI470X device (host builds only)
+ * @details SI470XSim is an SI470XBus implementation that emulates the SI4702/03 register file.
+ * @details It follows the device I2C behaviour: writes start at register 0x02 and reads start at register 0x0A, both wrapping after 0x0F to 0x00.
+ * @details Tune and seek take time (see setTuneTime and setSeekStepTime) and set the STC bit when complete.
+ * @details RDS groups can be sent (see setRdsGroups) and the GPIO2 interrupts (STCIEN and RDSIEN) can be emulated (see setInterruptPin).
+ * @details It allows running, measuring and benchmarking the SI470X library on Linux or macOS without a radio.
+ * @code
+ * si470x_sim_station stations[] = { {100, 45}, {150, 30} }; // channel, RSSI
+ * SI470XSim sim;
+ * SI470X rx;
+ *
+ * int main() {
+ *   si470xHostUseVirtualClock(true);
+ *   sim.setStations(stations, 2);
+ *   rx.setBus(&sim);
+ *   rx.setup(0, -1);
+ *   rx.setFrequency(10390);
+ *   printf("%u bytes read\n", rx.getBusStats().bytesRead);
+ * }
+ * @endcode
+ *
+ * This library can be freely distributed using the MIT Free Software model.
+ * Copyright (c) 2020 Ricardo Lima Caratti.
+ * Contact: pu2clr@gmail.com
+ */
+
+#ifndef SI470X_SIM_H
+#define SI470X_SIM_H
+
+#if !defined(ARDUINO)
+
+#include "SI470X.h"
+
+#define SI470X_SIM_TUNE_TIME 60000     //!< Default tune time in microseconds
+#define SI470X_SIM_SEEK_STEP_TIME 5000 //!< Default time in microseconds spent on each channel during a seek
+#define SI470X_SIM_NOISE_RSSI 8        //!< RSSI reported on channels without station
+#define SI470X_SIM_BUS_CLOCK 100000    //!< Default simulated I2C clock in Hz
+#define SI470X_SIM_RDS_GROUP_TIME 87600 //!< Time in microseconds between two RDS groups (1187.5 bps, 104 bits per group)
+#define SI470X_SIM_RDS_READY_TIME 40000 //!< Time in microseconds RDSR stays set after a new group
+
+/**
+ * @brief Simulated station
+ */
+typedef struct
+{
+    uint16_t channel; //!< Channel (CHAN) of the station. Depends on the band and space configured by the application.
+    uint8_t rssi;     //!< RSSI in dBuV
+    const si470x_rds_group *rdsGroups; //!< RDS groups of the station (NULL = the groups set by SI470XSim::setRdsGroups)
+    uint8_t rdsGroupCount;             //!< Number of groups in rdsGroups
+} si470x_sim_station;
+
+/**
+ * @brief Simulated SI470X device
+ */
+class SI470XSim : public SI470XBus
+{
+protected:
+    uint16_t registers[16];
+    uint8_t address;
+
+    const si470x_sim_station *stations = NULL;
+    uint8_t stationCount = 0;
+
+    uint32_t tuneTime = SI470X_SIM_TUNE_TIME;
+    uint32_t seekStepTime = SI470X_SIM_SEEK_STEP_TIME;
+    uint32_t busClock = SI470X_SIM_BUS_CLOCK;
+
+    int interruptPin = -1; //!< Host pin "connected" to GPIO2. See setInterruptPin
+
+    const si470x_rds_group *rdsGroups = NULL;
+    uint16_t rdsGroupCount = 0;
+    uint16_t rdsIndex = 0;
+
+    const si470x_sim_station *stationOf(uint16_t channel);
+    const si470x_rds_group *rdsGroupsOf(uint16_t channel, uint16_t *count);
+    unsigned long rdsTime; //!< micros() of the latest RDS group (or of the RDS start)
+
+    bool tuning = false;
+    bool seeking = false;
+    uint16_t seekStartChannel;
+    unsigned long operationTime; //!< micros() of the start of the current tune or seek step
+
+    uint16_t channelCount();
+    uint8_t rssiOf(uint16_t channel);
+    void setReadChannel(uint16_t channel);
+    void setStc(bool failed);
+    void registersWritten(uint16_t old02, uint16_t old03);
+    void busTime(uint8_t size);
+    void pulse();
+    bool rdsActive();
+    void sendRdsGroup();
+
+public:
+    uint32_t writeTransactions = 0; //!< Write transactions received by the simulated device
+    uint32_t readTransactions = 0;  //!< Read transactions received by the simulated device
+    uint32_t bytesWritten = 0;      //!< Bytes received by the simulated device
+    uint32_t bytesRead = 0;         //!< Bytes sent by the simulated device
+    uint32_t interrupts = 0;        //!< GPIO2 pulses sent (see setInterruptPin)
+    uint32_t rdsGroupsSent = 0;     //!< RDS groups delivered to the RDS registers
+    unsigned long stcTime = 0;      //!< micros() when STC was set by the latest tune or seek
+
+    SI470XSim(uint8_t address = I2C_DEVICE_ADDR);
+
+    void reset();
+    void update();
+
+    /**
+     * @brief Sets the list of stations "on the air"
+     * @details The array is not copied: change the RSSI of a station to simulate fading (mobile reception).
+     * @param stations array of stations (it is not copied)
+     * @param count number of stations
+     */
+    inline void setStations(const si470x_sim_station *stations, uint8_t count)
+    {
+        this->stations = stations;
+        this->stationCount = count;
+    };
+
+    /**
+     * @brief Sets the RDS groups "on the air"
+     * @details While RDS is enabled (04h RDS = 1), a station is tuned and no tune or seek is in progress, the groups are delivered one by one, in a loop,
+     * @details every 87.6 ms (RDSR = 1 for 40 ms, GPIO2 pulse if RDSIEN = 1). The bler field sets the block errors reported.
+     * @details In standard mode (RDSM = 0), groups with uncorrectable blocks (BLER = 3) are not delivered and BLERA is always 0.
+     * @param groups array of groups (it is not copied)
+     * @param count number of groups
+     */
+    inline void setRdsGroups(const si470x_rds_group *groups, uint16_t count)
+    {
+        this->rdsGroups = groups;
+        this->rdsGroupCount = count;
+        this->rdsIndex = 0;
+    };
+
+    /**
+     * @brief Sets the time from TUNE = 1 to STC = 1
+     * @param us microseconds
+     */
+    inline void setTuneTime(uint32_t us) { tuneTime = us; };
+
+    /**
+     * @brief Sets the time spent on each channel during a seek
+     * @param us microseconds
+     */
+    inline void setSeekStepTime(uint32_t us) { seekStepTime = us; };
+
+    /**
+     * @brief Sets the simulated I2C clock
+     * @details In virtual time (see si470xHostUseVirtualClock), each transaction advances the clock by the time the bytes would take on the wire.
+     * @param hz  clock in Hz (default 100 kHz)
+     */
+    inline void setBusClock(uint32_t hz) { busClock = hz; };
+
+    void setInterruptPin(int pin);
+
+    /**
+     * @brief Gets the current content of a simulated register
+     * @param reg register number (0x00 to 0x0F)
+     */
+    inline uint16_t getRegister(uint8_t reg) { update(); return registers[reg & 0x0F]; };
+
+    /**
+     * @brief Resets the traffic counters of the simulated device
+     */
+    inline void resetCounters() { writeTransactions = readTransactions = bytesWritten = bytesRead = interrupts = rdsGroupsSent = 0; };
+
+    uint8_t write(uint8_t address, const uint8_t *data, uint8_t size);
+    uint8_t read(uint8_t address, uint8_t *data, uint8_t size);
+    uint8_t probe(uint8_t address);
+};
+
+/**
+ * @brief Replays RDS groups recorded by SI470X::setRdsRecorder
+ * @details The recording is a sequence of SI470X_RDS_RECORD_SIZE bytes records (see SI470X_RDS_RECORD_SIZE).
+ * @details The groups go to the same decoder used with the device (SI470X::processRdsGroup), so a field recording reproduces
+ * @details the decoding behaviour on the computer and can be used to measure the decoder throughput.
+ * @code
+ * SI470XRdsReplay replay;
+ * SI470X rx;
+ *
+ * if (replay.load("field.rds")) {
+ *   rx.clearRdsBuffer();
+ *   replay.decode(rx);
+ *   printf("%s\n", rx.getRdsStationName());
+ * }
+ * @endcode
+ */
+class SI470XRdsReplay
+{
+protected:
+    const uint8_t *data = NULL;
+    size_t size = 0;
+    size_t position = 0;
+    uint8_t *loaded = NULL; //!< Buffer allocated by load
+
+public:
+    SI470XRdsReplay() {};
+    SI470XRdsReplay(const uint8_t *data, size_t size);
+    ~SI470XRdsReplay();
+
+    void setRecording(const uint8_t *data, size_t size);
+    bool load(const char *path);
+    bool next(si470x_rds_group *group, uint16_t *delta = NULL);
+    uint32_t decode(SI470X &rx, bool timed = false);
+
+    /**
+     * @brief Goes back to the first group
+     */
+    inline void rewind() { position = 0; };
+
+    /**
+     * @brief Gets the number of groups of the recording
+     */
+    inline size_t getGroupCount() { return size / SI470X_RDS_RECORD_SIZE; };
+};
+
+#if defined(__linux__)
+#include "SI470XLinuxBus.h"
+
+#define SI470X_SIM_FAKE_FD 1000 //!< File descriptor number used by SI470XSimLinuxBus (never passed to the kernel)
+
+/**
+ * @brief SI470XLinuxBus connected to a simulated device instead of /dev/i2c-N
+ * @details It is a stand-in for the i2c-dev file descriptor: each I2C_RDWR message is delivered to an SI470XSim,
+ * @details which emulates the device register order (reads from 0x0A to 0x0F and then from 0x00; writes from 0x02).
+ * @details Use it to test the Linux transport, including the combined write/read transactions, without hardware.
+ * @code
+ * SI470XSim sim;
+ * SI470XSimLinuxBus bus(&sim);
+ * SI470X rx;
+ *
+ * rx.setBus(&bus);
+ * rx.setup(-1, -1);
+ * printf("%u kernel calls\n", bus.kernelCalls);
+ * @endcode
+ */
+class SI470XSimLinuxBus : public SI470XLinuxBus
+{
+protected:
+    SI470XSim *sim;
+    int transfer(struct i2c_msg *msgs, int count);
+
+public:
+    /**
+     * @brief Creates the stand-in transport
+     * @param sim simulated device
+     */
+    SI470XSimLinuxBus(SI470XSim *sim) : SI470XLinuxBus(SI470X_SIM_FAKE_FD) { this->sim = sim; };
+};
+#endif
+
+#endif
+#endif